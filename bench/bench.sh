@@ -0,0 +1,110 @@
+#!/bin/bash
+# Benchmark suite for all solvers (make bench, make bench-quick, make bench-baseline).
+# Each run prints its statistics (solver option --stats, see IQpuzzler_options.hpp), which are collected
+# into one CSV file: nodes and placements tried (per second), time to first and 100th solution and total time in ms.
+# Bounded runs (--depth) search only the first levels of the search tree of every solver and input file
+# and finish in seconds. Complete runs check the number of solutions (correctness gates), the suite fails
+# if any count differs. The rectangle is checked with the counter (--count, transposition table) and by
+# enumerating all solutions with the threaded search. If a baseline file exists, nodes/s and total time
+# are compared with it.
+# All runs are started in a temporary folder, so the solution files in bin are not touched.
+#
+# Usage: bench/bench.sh [--quick] [results.csv] [baseline.csv]
+# --quick: bounded runs only (no correctness gates)
+#
+# Last update: 10/17/2026
+
+cd "$(dirname "$0")/.." || exit 1
+ROOT=$(pwd)
+BIN=$ROOT/bin
+QUICK=0
+if [ "$1" = "--quick" ]; then
+    QUICK=1
+    shift
+fi
+RESULTS=${1:-$ROOT/bench/results.csv}
+BASELINE=${2:-$ROOT/bench/baseline.csv}
+NTH=100
+
+# name | solver | input | options | expected number of solutions (- = bounded run, not checked)
+BOUNDED="
+rect_orig_d4     | IQpuzzler_rect | orig  | --depth 4                         | -
+rect_cross_d4    | IQpuzzler_rect | cross | --depth 4                         | -
+rect_long_d4     | IQpuzzler_rect | long  | --depth 4                         | -
+diag_orig_d5     | IQpuzzler_diag | orig  | --depth 5                         | -
+diag_cross_d6    | IQpuzzler_diag | cross | --depth 6                         | -
+diag_long_d6     | IQpuzzler_diag | long  | --depth 6                         | -
+pyra_orig_d4     | IQpuzzler_pyra | orig  | --depth 4                         | -
+pyra_cross_d5    | IQpuzzler_pyra | cross | --depth 5                         | -
+pyra_long_d5     | IQpuzzler_pyra | long  | --depth 5                         | -
+knuth_orig_d5    | knuth_rect     | orig  | --depth 5                         | -
+knuth_cross_d7   | knuth_rect     | cross | --depth 7                         | -
+knuth_long_d7    | knuth_rect     | long  | --depth 7                         | -
+knuth_diag_d6    | knuth_diag     | orig  | --depth 6                         | -
+knuth_pyra_d5    | knuth_pyra     | orig  | --depth 5                         | -
+"
+GATES="
+rect_orig_count  | IQpuzzler_rect | orig  | --count --branch first            | 1082785
+rect_orig        | IQpuzzler_rect | orig  | --threads 4 --branch first        | 1082785
+rect_cross       | IQpuzzler_rect | cross | --branch first                    | 112
+rect_long        | IQpuzzler_rect | long  | --branch first                    | 1615
+diag_orig        | IQpuzzler_diag | orig  |                                   | 77822
+diag_orig_all    | IQpuzzler_diag | orig  | --count --branch first --symmetry off | 155644
+diag_cross       | IQpuzzler_diag | cross |                                   | 19
+diag_long        | IQpuzzler_diag | long  |                                   | 23
+pyra_orig        | IQpuzzler_pyra | orig  | --branch fewest                   | 4360
+knuth_cross      | knuth_rect     | cross |                                   | 112
+knuth_long       | knuth_rect     | long  |                                   | 1615
+knuth_diag_cross | knuth_diag     | cross |                                   | 38
+knuth_diag_long  | knuth_diag     | long  |                                   | 46
+knuth_pyra_orig  | knuth_pyra     | orig  |                                   | 4360
+"
+
+WORK=$(mktemp -d) || exit 1
+trap 'rm -rf "$WORK"' EXIT
+cp "$BIN"/*.2di "$BIN"/*.3di "$WORK"
+failed=0
+
+echo "name,solver,input,options,solutions,expected,status,nodes,tested,nodes_per_s,tested_per_s,first_ms,nth_ms,total_ms" > "$RESULTS"
+runs="$BOUNDED"
+[ $QUICK = 1 ] || runs="$BOUNDED$GATES"
+while IFS='|' read -r name solver input options expected; do
+    name=$(echo $name); solver=$(echo $solver); input=$(echo $input); options=$(echo $options); expected=$(echo $expected)
+    [ -z "$name" ] && continue
+    if [ "${solver#knuth_}" != "$solver" ]; then
+        line=$(cd "$WORK" && "$BIN/$solver" $input $options --stats $NTH | grep '^stats ')
+    else
+        line=$(cd "$WORK" && "$BIN/$solver" $input --quiet --checkpoint 0 $options --stats $NTH | grep '^stats ')
+    fi
+    # key=value pairs of statistics line
+    get() { echo "$line" | tr ' ' '\n' | sed -n "s/^$1=//p"; }
+    solutions=$(get solutions)
+    if [ -z "$line" ]; then
+        status=error
+    elif [ "$expected" = - ]; then
+        status=bounded
+    elif [ "$solutions" = "$expected" ]; then
+        status=ok
+    else
+        status=FAILED
+    fi
+    [ $status = error ] || [ $status = FAILED ] && failed=1
+    printf "%-17s %-8s %10s solutions %12s nodes/s %9s ms\n" "$name" "$status" "$solutions" "$(get nodes_per_s)" "$(get total_ms)"
+    echo "$name,$solver,$input,$options,$solutions,$expected,$status,$(get nodes),$(get tested),$(get nodes_per_s),$(get tested_per_s),$(get first_ms),$(get nth_ms),$(get total_ms)" >> "$RESULTS"
+done <<< "$runs"
+echo "Results written to $RESULTS."
+
+# comparison with baseline: ratio of nodes/s and total time, changed number of nodes means a different search tree
+if [ -f "$BASELINE" ] && [ "$BASELINE" != "$RESULTS" ]; then
+    echo "Comparison with $BASELINE (nodes/s and total time, new/baseline):"
+    awk -F, 'NR == FNR { if (FNR > 1) { nodes[$1] = $8; rate[$1] = $10; total[$1] = $14 } next }
+             FNR > 1 && ($1 in rate) {
+                 printf "%-17s %6.2fx nodes/s %6.2fx time%s\n", $1, rate[$1] ? $10/rate[$1] : 0,
+                        total[$1] ? $14/total[$1] : 0, nodes[$1] != $8 ? "  (nodes " nodes[$1] " -> " $8 ")" : ""
+             }' "$BASELINE" "$RESULTS"
+fi
+
+if [ $failed = 1 ]; then
+    echo "Benchmark FAILED: wrong number of solutions or solver error."
+    exit 1
+fi
@@ -0,0 +1,2409 @@
+// Bitboard search engine for all IQpuzzler games (5x11 rectangle, diagonal arrangement and pyramid).
+// The engine is a template on the board geometry (see IQpuzzler_geometry.hpp), the front ends only instantiate it.
+// All boards consist of 55 fields, so the occupation of the whole board fits into a single 64 bit word.
+// Fields are numbered layer by layer, row by row (bit 0 is the first field of the top row of the first layer).
+// The cell map (bit index of each position), coordinates and neighbour masks of all fields are computed at compile time.
+//
+// At load time, each part orientation is compiled into one occupancy mask per position on the board
+// (only positions where the part fits completely into the board shape are kept).
+// Fit test, placing and removing a part are reduced to a single AND, OR and XOR operation.
+// The fit test runs over blocks of placements, and the inner kernels of the search (fit test, window index, flood fill,
+// cavity check, first empty field) are compiled for several instruction sets and selected at startup (see IQpuzzler_cpu.hpp).
+// All placements are stored in one flat, cache-aligned table (structure of arrays, in search order),
+// the search refers to them by index, and the placements of each field are kept in contiguous lists.
+// With --compile, the tables are written to a cache file (see IQpuzzler_cache.hpp), later runs use them in place via mmap.
+//
+// Dead space detection is incremental: after each placement, only the free fields next to the new part are checked.
+// A lookup table, indexed by the occupancy of the fields within distance 2 of a field, yields the size of its free region
+// inside this window (2D boards only). Only if the window does not prove that the region is large enough, a bounded
+// flood fill follows. Enclosed pockets smaller than the smallest remaining part are rejected, whatever their shape.
+// Pockets smaller than twice the smallest remaining part can only be filled by a single part, so they are rejected
+// if no remaining part fits exactly.
+// Finally, the free fields are split into connected regions (flood fill), and the size of each region has to be
+// a sum of sizes of the remaining parts (possible sums are precomputed for each set of remaining parts).
+// If parts can lie in several planes (pyramid), free fields which have no free neighbour space on any plane
+// (isolated cavities) are rejected before, only fields near the new part are checked.
+//
+// Branching of the search (--branch):
+// part   = parts are placed in order of the input file, each part is tried at all positions (original search order).
+// first  = the first empty field has to be covered next, so only placements of remaining parts
+//          whose first field is this field are tried (fields are scanned line by line along the shorter side of the board).
+// fewest = the empty field with the fewest fitting placements of remaining parts is covered next.
+// Both field based modes use precomputed lists of placements for each field and find the same solutions in a different order.
+//
+// Symmetric solutions (--symmetry): the symmetries of the board shape (up to 8 rotations and reflections of the grid)
+// which also map the placements of each part onto placements of the same part form the symmetry group of the puzzle.
+// If the input file already restricts the orientations of a part, the group is reduced accordingly (often to the identity).
+// break = one part is restricted to one placement of each orbit (set of placements which are mapped onto each other).
+//         For placements which are mapped onto themselves by some symmetries, the solutions are still compared
+//         with their images under these symmetries, and only the smallest one is logged.
+// dedup = full search, each solution is compared with all its images, and only the smallest one is logged.
+//
+// The search can run sequentially or in parallel:
+// the search tree is split at the first one or two part levels into tasks for a work-stealing thread pool.
+// Each task has its own board and solution buffer, buffers are merged in sequential search order.
+//
+// The current board is handed over to the terminal visualization on request (see IQpuzzler_render.hpp).
+//
+// Sharding (--shard I/N): the search tree is split into tasks as for parallel search (at least 16 per shard),
+// the size of each task is estimated by random descents with fixed seeds, and each shard searches a consecutive range
+// of tasks with about 1/N of the estimated size. All processes compute the same ranges, so shards can run on
+// different machines without communication. --merge N concatenates the solution files of the shards in order.
+//
+// Checkpoints (--checkpoint, see IQpuzzler_checkpoint.hpp): when a node of the first CHECKPOINT_DEPTH levels is entered
+// (in parallel search: when a task has been merged), the solution file is flushed and the path of the node is saved,
+// at most once per interval. --resume truncates the solution file to its size at the checkpoint and replays the search:
+// on the levels of the saved path, all placements before the path are skipped, so the search continues with the
+// subtree of the saved node, and the solution file is the same as without interruption (except for the time stamps).
+//
+// With --count, solutions are only counted, and the number of completions of each search state (occupied fields,
+// remaining parts) is kept in a transposition table (see IQpuzzler_memo.hpp). States whose completions could be
+// rejected as symmetric images (symmetric part not placed yet or placed on a self-symmetric placement, --symmetry dedup)
+// are searched without the table. In parallel search, each thread has its own table.
+//
+// Instrumentation (--metrics, compiled in with SEARCH_METRICS, see IQpuzzler_metrics.hpp): for each depth and part,
+// placements are counted when they are tried, rejected by overlap or by one of the dead space checks
+// (isolated cavity, pocket smaller than any remaining part, pocket without exactly fitting part, region size),
+// and when they pass all checks. dead_space returns the check which rejected the placement.
+//
+// Challenges (--challenge FILE): the search starts from a position with pre-placed parts, given as grid in the layout
+// of the log file ('.' = empty field) or as placements (part letter, orientation and position of its origin),
+// and stops after --limit solutions. All challenges of the file are solved as tasks of the thread pool
+// (the search of each challenge is sequential), results are written in the order of the file.
+// The placement table is built without symmetry reduction, because the pre-placed parts break the symmetry.
+// The daemon (--serve, see IQpuzzler_server.hpp) keeps the placement tables of several input files in memory
+// and answers challenges sent as binary queries, with a solution limit and a time budget for each query.
+//
+// Solutions are logged as text grids, or with --output binary as short codes (see IQpuzzler_solutions.hpp):
+// the fields are covered in scan order, and the placement which covers the first free field is stored as its rank
+// among the fitting placements of the remaining parts which start at this field (with as many bits as this number needs).
+// The code doesn't depend on the search order, and most solutions need less than 6 bytes.
+// --convert and --solution render the binary file as text, the placement table is rebuilt with the symmetry mode
+// of the file and has to match its hash.
+//
+// Solution index (--index, see IQpuzzler_index.hpp): for each placement and for each field and part, the set of
+// solutions of the binary solution file which contain it. --lookup answers challenges by intersecting these sets,
+// without search. If the file holds one solution of each set of symmetric solutions, the challenge is mapped by each
+// symmetry of the puzzle, and the solutions found are mapped back (a solution which is its own image under
+// a symmetry would be counted for each such symmetry, the parts of the games have no such solutions).
+//
+// Last update: 10/17/2026
+
+#ifndef _IQPUZZLER_BITBOARD_
+#define _IQPUZZLER_BITBOARD_
+
+#include "IQpuzzler_read_input.hpp"     // read part shapes and orientations from input file
+#include "IQpuzzler_options.hpp"        // command line options
+#include "IQpuzzler_threads.hpp"        // work-stealing thread pool
+#include "IQpuzzler_render.hpp"         // terminal visualization
+#include "IQpuzzler_geometry.hpp"       // board geometries
+#include "IQpuzzler_shapes.hpp"         // flat table of part orientations
+#include "IQpuzzler_cache.hpp"          // binary cache files
+#include "IQpuzzler_solutions.hpp"      // binary solution files
+#include "IQpuzzler_memo.hpp"           // transposition table for counting
+#include "IQpuzzler_checkpoint.hpp"     // checkpoint files
+#include "IQpuzzler_metrics.hpp"        // search instrumentation
+#include "IQpuzzler_server.hpp"         // solver daemon
+#include "IQpuzzler_index.hpp"          // indexed solution database
+#include "IQpuzzler_cpu.hpp"            // search kernels (runtime CPU dispatch)
+#include "IQpuzzler_orientations.hpp"   // built-in part sets
+#include <cstdio>                       // remove
+#include <unistd.h>                     // truncate
+#include <cstring>                      // strncpy, strncmp
+#include <atomic>                       // atomic
+#include <array>                        // array
+#include <map>                          // map
+#include <unordered_map>                // unordered_map
+#include <unordered_set>                // unordered_set
+#include <algorithm>                    // lexicographical_compare
+#include <iomanip>                      // setprecision
+#include <sstream>                      // istringstream
+#include <memory>                       // unique_ptr
+
+#define BUILTIN_SOURCE "/proc/self/exe"  // source of built-in part sets: their cache files have to be newer than the solver
+#define MAX_FIELDS 64
+#define MAX_PARTS 16
+#define MAX_CODE (2*MAX_PARTS)  // bytes of binary code of a solution
+#define CHECKPOINT_DEPTH 4      // checkpoints are saved at nodes up to this level
+#define SHARD_PROBES 16         // random descents to estimate the size of a task
+
+typedef uint64_t bitboard;
+
+// result of dead space detection: no dead space, or the check which found it
+enum dead_space_check {SPACE_OK, SPACE_CAVITY, SPACE_POCKET_SMALL, SPACE_POCKET_FIT, SPACE_REGION};
+
+typedef uint16_t placement_index;
+
+// read-only view of the placement table, either built from the input file or mapped from a cache file
+struct placement_view
+{
+    size_t count = 0;
+    const bitboard *mask = nullptr, *affected = nullptr;
+    const uint8_t *part = nullptr, *stabilizer = nullptr, *orientation = nullptr, *layer = nullptr, *row = nullptr, *col = nullptr;
+    const placement_index *part_begin = nullptr;
+
+    size_t size() const { return count; }
+};
+
+// read-only view of the placements for each field
+struct field_view
+{
+    const uint32_t *begin = nullptr;
+    const placement_index *list = nullptr;
+    const bitboard *mask = nullptr;
+    const uint8_t *part = nullptr;
+};
+
+// parts placed with given orientation at given position, as structure of arrays in contiguous, cache-aligned memory
+// Placements are stored in search order (part, orientation, layer, row, col), so the placements of each part are contiguous.
+struct placement_table
+{
+    aligned_vector <bitboard> mask;         // occupied fields
+    aligned_vector <bitboard> affected;     // fields whose cavity check depends on the occupied fields (several planes only)
+    aligned_vector <uint8_t> part;          // part number
+    aligned_vector <uint8_t> stabilizer;    // symmetries which map the placement onto itself (bit n for symmetries[n])
+    aligned_vector <uint8_t> orientation, layer, row, col;
+    vector <placement_index> part_begin;    // first placement of each part (part_begin[partcount+1] = number of placements)
+
+    size_t size() const { return mask.size(); }
+    void clear()
+    {
+        mask.clear(); affected.clear(); part.clear(); stabilizer.clear();
+        orientation.clear(); layer.clear(); row.clear(); col.clear();
+    }
+    void push_back(bitboard m, bitboard a, uint8_t p, uint8_t o, uint8_t z, uint8_t y, uint8_t x)
+    {
+        mask.push_back(m); affected.push_back(a); part.push_back(p); stabilizer.push_back(0);
+        orientation.push_back(o); layer.push_back(z); row.push_back(y); col.push_back(x);
+    }
+    placement_view view() const;
+    // removes all placements i with !keep[i] and updates part_begin
+    void compact(const vector <bool> & keep)
+    {
+        size_t kept = 0;
+        for (size_t i = 0; i < size(); i++)
+            if (keep[i])
+            {
+                mask[kept] = mask[i]; affected[kept] = affected[i]; part[kept] = part[i]; stabilizer[kept] = stabilizer[i];
+                orientation[kept] = orientation[i]; layer[kept] = layer[i]; row[kept] = row[i]; col[kept] = col[i];
+                kept++;
+            }
+        mask.resize(kept); affected.resize(kept); part.resize(kept); stabilizer.resize(kept);
+        orientation.resize(kept); layer.resize(kept); row.resize(kept); col.resize(kept);
+        for (size_t p = 1; p < part_begin.size(); p++)
+            part_begin[p] = lower_bound(part.begin(), part.end(), p) - part.begin();
+    }
+};
+
+// placements for each field as one contiguous list (placements of field f are list[begin[f]] ... list[begin[f+1]-1])
+// Mask and part number of each entry are copied, so scanning a list does not jump around in the placement table.
+struct field_lists
+{
+    vector <uint32_t> begin;
+    aligned_vector <placement_index> list;
+    aligned_vector <bitboard> mask;
+    aligned_vector <uint8_t> part;
+
+    field_view view() const { return {begin.data(), list.data(), mask.data(), part.data()}; }
+};
+
+inline placement_view placement_table::view() const
+{
+    return {size(), mask.data(), affected.data(), part.data(), stabilizer.data(),
+            orientation.data(), layer.data(), row.data(), col.data(), part_begin.data()};
+}
+
+// solution found by parallel search, waiting to be merged
+struct found_solution
+{
+    uint32_t seconds;                   // time stamp
+    placement_index path[MAX_PARTS];    // placements in search order
+};
+
+// state of one search (one per task in parallel search)
+struct search_state
+{
+    bitboard occupied;                      // occupied fields
+    uint16_t remaining;                     // parts not yet on board (bit n for part n)
+    uint8_t depth;                          // number of parts on board
+    placement_index path[MAX_PARTS];        // placements of the parts on board, in search order
+    vector <found_solution> * found;        // solution buffer, nullptr for sequential search
+    uint64_t nodes;                         // statistics: placements which passed all checks (nodes of the search tree)
+    uint64_t tested;                        // statistics: placements tried
+    bool stop;                              // search is stopped (challenge: enough solutions found)
+};
+
+// starting position of a challenge
+struct challenge
+{
+    search_state start;                     // pre-placed parts
+    unsigned line;                          // first line of challenge in file
+    string error;                           // reason why challenge is invalid (empty = valid)
+    bitboard hints[MAX_PARTS];              // fields covered by each part (lowercase letters, only for the solution index)
+};
+
+// cell map and neighbourhood of the fields of a geometry, computed at compile time
+template <typename geometry>
+struct board_map
+{
+    static constexpr uint8_t DIRECTIONS = 4*geometry::PLANES;
+
+    int8_t field[geometry::LAYERS][geometry::ROWS][geometry::COLS] = {};   // bit index of each position, -1 outside of board
+    uint8_t layer[geometry::FIELDS] = {};                   // position of each field
+    uint8_t row[geometry::FIELDS] = {};
+    uint8_t col[geometry::FIELDS] = {};
+    bitboard all = 0;                                       // all fields of the board
+    bitboard neighbours[geometry::FIELDS] = {};             // neighbour fields in all directions
+    bitboard plane_neighbours[geometry::FIELDS][geometry::PLANES] = {};    // neighbour fields on each plane
+    bitboard next_field[geometry::FIELDS][DIRECTIONS] = {}; // neighbour field in each direction
+    bitboard further[geometry::FIELDS][DIRECTIONS] = {};    // further neighbour fields beyond next_field on same plane (except backwards)
+    bitboard region[geometry::FIELDS] = {};                 // all fields that are checked for cavities of a field
+    uint8_t fieldcount = 0;
+
+    // returns bit of field at layer,row,col or 0 if position is outside of board
+    constexpr bitboard bit(int z, int y, int x) const
+    {
+        if (z < 0 || y < 0 || x < 0 || z >= geometry::LAYERS || y >= geometry::ROWS || x >= geometry::COLS || field[z][y][x] < 0)
+            return 0;
+        return (bitboard)1 << field[z][y][x];
+    }
+
+    constexpr board_map()
+    {
+        for (int z = 0; z < geometry::LAYERS; z++)
+            for (int y = 0; y < geometry::ROWS; y++)
+                for (int x = 0; x < geometry::COLS; x++)
+                    if (geometry::field(z, y, x))
+                    {
+                        layer[fieldcount] = z;
+                        row[fieldcount] = y;
+                        col[fieldcount] = x;
+                        field[z][y][x] = fieldcount++;
+                    }
+                    else
+                        field[z][y][x] = -1;
+        all = fieldcount < 64 ? ((bitboard)1 << fieldcount) - 1 : ~(bitboard)0;
+
+        for (uint8_t i = 0; i < fieldcount; i++)
+            for (uint8_t d = 0; d < DIRECTIONS; d++)
+            {
+                const int8_t* step = geometry::DIRECTIONS[d];
+                next_field[i][d] = bit(layer[i]+step[0], row[i]+step[1], col[i]+step[2]);
+                neighbours[i] |= next_field[i][d];
+                plane_neighbours[i][d/4] |= next_field[i][d];
+                for (uint8_t turn = 3; turn < 6; turn++)    // all directions on same plane, except backwards
+                {   // instead of -1,0,1 use 3,4,5 to stay unsigned
+                    const int8_t* next = geometry::DIRECTIONS[(d & ~3) | ((d+turn) & 3)];
+                    further[i][d] |= bit(layer[i]+step[0]+next[0], row[i]+step[1]+next[1], col[i]+step[2]+next[2]);
+                }
+                region[i] |= next_field[i][d] | further[i][d];
+            }
+    }
+};
+
+template <typename geometry>
+class bitboard_solver
+{
+public:
+    static constexpr board_map <geometry> board{};
+    static_assert(board.fieldcount == geometry::FIELDS, "number of fields does not match board shape");
+    static_assert(geometry::FIELDS <= MAX_FIELDS, "board too large for bitboard");
+    static_assert(MAX_PARTS <= METRIC_DEPTHS && MAX_PARTS <= METRIC_PARTS, "too many parts for metrics");
+
+    uint8_t partcount;                                  // number of parts
+    placement_view placements;                          // placements of all parts that fit into the board, in search order
+    field_view covering;                                // placements of all parts which cover each field
+    field_view starting;                                // placements of all parts whose first field (in scan order) is each field
+    vector <vector <uint8_t> > symmetries;              // field permutation of each symmetry of the puzzle (without identity)
+    uint8_t symmetric_part = 0;                         // part restricted to one placement per orbit (0 = none)
+    atomic <uint64_t> solutions_found{0};               // solutions found by all threads
+    int solutions = 0;                                  // solutions logged
+    ofstream logfile;                                   // output: log file with solutions and time stamps
+    solution_writer binaryfile;                         // output: binary solution file (if open, instead of log file)
+    bool binary = false;                                // solutions are written to binary solution file
+    string checkpointfile;                              // output: checkpoint file
+    unsigned checkpoint_interval = 0;                   // minimum time between checkpoints in seconds (0 = none)
+    unsigned shard = 1, shards = 1;                     // search only part shard (1..shards) of the search tree
+    uint8_t depth_limit = MAX_PARTS;                    // nodes with this number of parts on board are not expanded
+    uint64_t nodes = 0, tested = 0;                     // statistics of the search: nodes and placements tried
+    uint64_t nth = 0;                                   // statistics: number of solution whose time is measured
+    atomic <int64_t> first_time{-1}, nth_time{-1};      // statistics: time to first and nth solution in ns (-1 = none)
+
+    void init(const shape_table & shapes, symmetry_mode symmetry);
+    bool load(const string & cachefile, const string & inputfile, symmetry_mode symmetry);
+    bool save(const string & cachefile, symmetry_mode symmetry) const;
+    uint64_t hash() const;
+    bool resume(const checkpoint & point);
+    void solve(unsigned threads, branch_mode branch);
+    uint64_t count(unsigned threads, branch_mode branch, size_t memory);
+    vector <challenge> read_challenges(const string & filename, bool hints = false) const;
+    size_t solve_challenges(const vector <challenge> & challenges, unsigned threads, branch_mode branch, uint64_t limit, ostream & out);
+    void set_branching(branch_mode branch);
+    void answer_query(const query & q, const query_placement parts[], chrono::steady_clock::time_point received,
+                      vector <uint8_t> & reply);
+    uint8_t encode(const placement_index path[MAX_PARTS], uint8_t code[MAX_CODE]) const;
+    bool decode(const uint8_t code[], uint8_t length, placement_index path[MAX_PARTS]) const;
+    void write_solution(ostream & out, const placement_index path[MAX_PARTS], uint64_t number, long seconds) const;
+
+private:
+    placement_table table;                              // storage of placements and lists compiled from input file
+    field_lists covering_lists, starting_lists;         // (unused if tables are mapped from cache file)
+    cache_reader cache;                                 // mapping of cache file
+    vector <uint8_t> part_size;                         // number of dots of each part
+    bitboard window[MAX_FIELDS] = {};                   // fields within distance 2 of each field (without field itself)
+    const uint8_t* window_size[MAX_FIELDS];             // size of free region inside window, indexed by occupancy of window
+    uint32_t window_offset[MAX_FIELDS] = {};            // position of lookup table of each field in window_tables
+    aligned_vector <uint8_t> window_tables;             // lookup tables, shared by fields with identical window shape
+    unordered_map <bitboard, uint16_t> pocket_parts;    // parts which fill a pocket exactly (bit n for part n)
+    vector <uint8_t> min_size;                          // size of smallest part for each set of remaining parts (bit n for part n)
+    vector <uint64_t> region_sizes;                     // possible region sizes (bit n for size n) for each set of remaining parts
+    vector <bitboard> scan_lines;                       // board fields line by line along the shorter side of the board
+    branch_mode branching;                              // selection of next search step
+    symmetry_mode symmetry;                             // handling of symmetric solutions
+    placement_index resume_path[MAX_PARTS];             // path of the node where a resumed search continues
+    uint8_t resume_depth = 0;                           // number of levels of resume_path (0 = no resumed search)
+    uint8_t replay = 0;                                 // levels of resume_path still to be replayed
+    uint32_t resume_seconds = 0;                        // run time before resumed search
+    chrono::steady_clock::time_point last_checkpoint;   // time of last checkpoint
+    chrono::steady_clock::time_point start;             // start of search
+
+    void init_scan_lines();
+    void init_tables();
+    void init_windows();
+    void init_symmetries(symmetry_mode symmetry);
+    vector <uint8_t> board_symmetry(uint8_t t) const;
+    uint8_t first_field(bitboard mask) const;
+    void fill_board(const placement_index path[MAX_PARTS], uint8_t depth, uint8_t cells[MAX_FIELDS]) const;
+    bool cavity(bitboard occupied, bitboard check) const;
+    dead_space_check dead_space(bitboard occupied, bitboard placed, bitboard affected, uint16_t remaining, bool all) const;
+    bool canonical(const search_state & s) const;
+    uint8_t fewest_field(const search_state & s) const;
+    template <typename step> void try_placement(search_state & s, placement_index p, step next);
+    template <typename step> void try_fitting(search_state & s, size_t begin, size_t end, const bitboard mask[],
+                                              const uint8_t part[], const placement_index list[], step next);
+    template <typename step> void branch(search_state & s, step next);
+    void find_position(search_state & s);
+    void find_completions(search_state & s, uint64_t limit, chrono::steady_clock::time_point deadline);
+    size_t find_placement(uint8_t part_number, int orientation, int z, int y, int x) const;
+    challenge parse_challenge(const vector <string> & lines, unsigned first_line, bool hints) const;
+    bool place(challenge & c, placement_index p) const;
+    void collect_tasks(search_state & s, uint8_t depth, vector <search_state> & tasks);
+    vector <search_state> split(search_state & s, unsigned threads);
+    double estimate(const search_state & s, uint64_t seed);
+    vector <search_state> shard_tasks(search_state & s);
+    void resume_tasks(vector <search_state> & tasks);
+    uint64_t count_completions(search_state & s, memo_table & memo);
+    void show_solution(const placement_index path[MAX_PARTS], long seconds);
+    void save_checkpoint(const placement_index path[MAX_PARTS], uint8_t depth);
+};
+
+// applies field permutation to mask
+inline bitboard transform(bitboard mask, const vector <uint8_t> & perm)
+{
+    bitboard result = 0;
+    for (; mask; mask &= mask-1)
+        result |= (bitboard)1 << perm[__builtin_ctzll(mask)];
+    return result;
+}
+
+template <typename geometry>
+void bitboard_solver<geometry>::init(const shape_table & shapes, symmetry_mode symmetry)
+{
+    bitboard mask, bit, affected;
+    bool fit;
+
+    partcount = shapes.partcount;
+    this->symmetry = symmetry;
+    part_size.assign(partcount+1, 0);
+    for (uint8_t part_number = 1; part_number <= partcount; part_number++)
+        part_size[part_number] = shapes.size(part_number);
+
+    // occupancy masks for each orientation (in order of parts) and position
+    table.clear();
+    table.part_begin.assign(partcount+2, 0);
+    for (size_t o = 0; o < shapes.orientations(); o++)
+    {
+        uint8_t part_number = shapes.part[o];
+        if (o == shapes.part_begin[part_number])
+            table.part_begin[part_number] = table.size();
+        const int8_t *dx = &shapes.dx[shapes.first[o]], *dy = &shapes.dy[shapes.first[o]], *dz = &shapes.dz[shapes.first[o]];
+        for (uint8_t z = 0; z < geometry::LAYERS; z++)
+            for (uint8_t y = 0; y < geometry::ROWS; y++)
+                for (uint8_t x = 0; x < geometry::COLS; x++)
+                {
+                    if (!geometry::anchor(z, y, x))
+                        continue;
+                    fit = true;
+                    mask = 0;
+                    for (uint8_t dot = 0; dot < shapes.dots[o]; dot++)
+                    {
+                        bit = board.bit(z + (geometry::DIMENSIONS > 2 ? dz[dot] : 0), y + dy[dot], x + dx[dot]);
+                        if (!bit)
+                            fit = false;    // dot out of board shape
+                        mask |= bit;
+                    }
+                    if (!fit)
+                        continue;
+                    affected = 0;
+                    if (geometry::PLANES > 1)
+                        for (uint8_t i = 0; i < geometry::FIELDS; i++)
+                            if (board.region[i] & mask)
+                                affected |= (bitboard)1 << i;
+                    table.push_back(mask, affected, part_number, o - shapes.part_begin[part_number], z, y, x);
+                }
+    }
+    table.part_begin[partcount+1] = table.size();
+    if (table.size() > UINT16_MAX)
+    {
+        cout<<"Too many placements ("<<table.size()<<")."<<endl;
+        exit(1);
+    }
+
+    init_symmetries(symmetry);
+    placements = table.view();
+    init_scan_lines();
+
+    // placements covering each field, in search order of parts (counted first, then filled into contiguous lists)
+    covering_lists.begin.assign(geometry::FIELDS+1, 0);
+    starting_lists.begin.assign(geometry::FIELDS+1, 0);
+    for (size_t i = 0; i < placements.size(); i++)
+    {
+        for (mask = placements.mask[i]; mask; mask &= mask-1)
+            covering_lists.begin[__builtin_ctzll(mask)+1]++;
+        starting_lists.begin[first_field(placements.mask[i])+1]++;
+    }
+    for (uint8_t f = 0; f < geometry::FIELDS; f++)
+    {
+        covering_lists.begin[f+1] += covering_lists.begin[f];
+        starting_lists.begin[f+1] += starting_lists.begin[f];
+    }
+    covering_lists.list.resize(covering_lists.begin[geometry::FIELDS]);
+    starting_lists.list.resize(starting_lists.begin[geometry::FIELDS]);
+    vector <uint32_t> covering_end(covering_lists.begin.begin(), covering_lists.begin.end()-1);
+    vector <uint32_t> starting_end(starting_lists.begin.begin(), starting_lists.begin.end()-1);
+    for (size_t i = 0; i < placements.size(); i++)
+    {
+        for (mask = placements.mask[i]; mask; mask &= mask-1)
+            covering_lists.list[covering_end[__builtin_ctzll(mask)]++] = i;
+        starting_lists.list[starting_end[first_field(placements.mask[i])]++] = i;
+    }
+    for (field_lists* l : {&covering_lists, &starting_lists})
+    {
+        l->mask.resize(l->list.size());
+        l->part.resize(l->list.size());
+        for (size_t k = 0; k < l->list.size(); k++)
+        {
+            l->mask[k] = placements.mask[l->list[k]];
+            l->part[k] = placements.part[l->list[k]];
+        }
+    }
+    covering = covering_lists.view();
+    starting = starting_lists.view();
+
+    if (geometry::WINDOW)
+        init_windows();
+    init_tables();
+}
+
+// maps placement table and lists from cache file, if it is newer than the input file and was compiled with the same symmetry mode
+template <typename geometry>
+bool bitboard_solver<geometry>::load(const string & cachefile, const string & inputfile, symmetry_mode symmetry)
+{
+    const cache_header * header = cache.open(cachefile, inputfile);
+
+    if (!header || strncmp(header->board, geometry::NAME, sizeof(header->board)) || header->symmetry != symmetry)
+        return false;
+    partcount = header->partcount;
+    this->symmetry = symmetry;
+    symmetric_part = header->symmetric_part;
+    placements.count = header->placements;
+    placements.mask = cache.section <bitboard> (header->placements);
+    placements.affected = cache.section <bitboard> (header->placements);
+    placements.part = cache.section <uint8_t> (header->placements);
+    placements.stabilizer = cache.section <uint8_t> (header->placements);
+    placements.orientation = cache.section <uint8_t> (header->placements);
+    placements.layer = cache.section <uint8_t> (header->placements);
+    placements.row = cache.section <uint8_t> (header->placements);
+    placements.col = cache.section <uint8_t> (header->placements);
+    placements.part_begin = cache.section <placement_index> (partcount+2);
+    covering.begin = cache.section <uint32_t> (geometry::FIELDS+1);
+    covering.list = cache.section <placement_index> (header->covering);
+    covering.mask = cache.section <bitboard> (header->covering);
+    covering.part = cache.section <uint8_t> (header->covering);
+    starting.begin = cache.section <uint32_t> (geometry::FIELDS+1);
+    starting.list = cache.section <placement_index> (header->starting);
+    starting.mask = cache.section <bitboard> (header->starting);
+    starting.part = cache.section <uint8_t> (header->starting);
+    const uint8_t * sizes = cache.section <uint8_t> (partcount+1);
+    const uint8_t * perms = cache.section <uint8_t> (header->symmetry_count * geometry::FIELDS);
+    const bitboard * windows = cache.section <bitboard> (geometry::FIELDS);
+    const uint32_t * offsets = cache.section <uint32_t> (geometry::FIELDS);
+    const uint8_t * tables = cache.section <uint8_t> (header->windows);
+    if (!tables)
+        return false;   // file truncated
+    part_size.assign(sizes, sizes + partcount+1);
+    symmetries.clear();
+    for (uint8_t t = 0; t < header->symmetry_count; t++)
+        symmetries.push_back(vector <uint8_t>(perms + t*geometry::FIELDS, perms + (t+1)*geometry::FIELDS));
+    for (uint8_t f = 0; f < geometry::FIELDS && geometry::WINDOW; f++)
+    {
+        window[f] = windows[f];
+        window_size[f] = tables + offsets[f];
+    }
+
+    init_scan_lines();
+    init_tables();
+    return true;
+}
+
+// writes placement table and lists to cache file
+template <typename geometry>
+bool bitboard_solver<geometry>::save(const string & cachefile, symmetry_mode symmetry) const
+{
+    cache_writer file;
+    cache_header header = {};
+
+    if (!file.open(cachefile))
+        return false;
+    strncpy(header.board, geometry::NAME, sizeof(header.board));
+    header.symmetry = symmetry;
+    header.partcount = partcount;
+    header.symmetric_part = symmetric_part;
+    header.symmetry_count = symmetries.size();
+    header.placements = placements.size();
+    header.covering = covering.begin[geometry::FIELDS];
+    header.starting = starting.begin[geometry::FIELDS];
+    file.section(placements.mask, header.placements * sizeof(bitboard));
+    file.section(placements.affected, header.placements * sizeof(bitboard));
+    file.section(placements.part, header.placements);
+    file.section(placements.stabilizer, header.placements);
+    file.section(placements.orientation, header.placements);
+    file.section(placements.layer, header.placements);
+    file.section(placements.row, header.placements);
+    file.section(placements.col, header.placements);
+    file.section(placements.part_begin, (partcount+2) * sizeof(placement_index));
+    for (const field_view * l : {&covering, &starting})
+    {
+        file.section(l->begin, (geometry::FIELDS+1) * sizeof(uint32_t));
+        file.section(l->list, l->begin[geometry::FIELDS] * sizeof(placement_index));
+        file.section(l->mask, l->begin[geometry::FIELDS] * sizeof(bitboard));
+        file.section(l->part, l->begin[geometry::FIELDS]);
+    }
+    file.section(part_size.data(), partcount+1);
+    vector <uint8_t> perms;
+    for (size_t t = 0; t < symmetries.size(); t++)
+        perms.insert(perms.end(), symmetries[t].begin(), symmetries[t].end());
+    file.section(perms.data(), perms.size());
+    file.section(window, geometry::FIELDS * sizeof(bitboard));
+    file.section(window_offset, geometry::FIELDS * sizeof(uint32_t));
+    header.windows = window_tables.size();
+    file.section(window_tables.data(), window_tables.size());
+    return file.close(header);
+}
+
+// FNV-1a hash of the placement table (masks and parts in search order), identifies the placement indices of a solution file
+template <typename geometry>
+uint64_t bitboard_solver<geometry>::hash() const
+{
+    uint64_t h = 14695981039346656037ull;
+
+    for (size_t i = 0; i < placements.size(); i++)
+    {
+        for (uint8_t byte = 0; byte < 8; byte++)
+            h = (h ^ (placements.mask[i] >> 8*byte & 0xff)) * 1099511628211ull;
+        h = (h ^ placements.part[i]) * 1099511628211ull;
+    }
+    return h;
+}
+
+// continues the search at the node of a checkpoint, returns false if it doesn't match the placement table
+template <typename geometry>
+bool bitboard_solver<geometry>::resume(const checkpoint & point)
+{
+    if (strncmp(point.board, geometry::NAME, sizeof(point.board)) || point.hash != hash() || point.depth >= partcount)
+        return false;
+    for (uint8_t d = 0; d < point.depth; d++)
+    {
+        const checkpoint_level & l = point.level[d];
+        size_t i = 0;
+        while (i < placements.size() && (placements.part[i] != l.part || placements.orientation[i] != l.orientation
+               || placements.layer[i] != l.layer || placements.row[i] != l.row || placements.col[i] != l.col))
+            i++;
+        if (i == placements.size())
+            return false;
+        resume_path[d] = i;
+    }
+    resume_depth = point.depth;
+    resume_seconds = point.seconds;
+    solutions = point.solutions;
+    solutions_found = point.solutions;
+    return true;
+}
+
+// scan board column by column if it is wider than high (short lines keep the filled area compact)
+template <typename geometry>
+void bitboard_solver<geometry>::init_scan_lines()
+{
+    bitboard mask;
+
+    scan_lines.clear();
+    for (int z = 0; z < geometry::LAYERS; z++)
+        for (int line = 0; line < max(geometry::ROWS, geometry::COLS); line++)
+        {
+            mask = 0;
+            if (geometry::COLS > geometry::ROWS)
+                for (int y = 0; y < geometry::ROWS; y++)
+                    mask |= board.bit(z, y, line);
+            else
+                for (int x = 0; x < geometry::COLS; x++)
+                    mask |= board.bit(z, line, x);
+            if (mask)
+                scan_lines.push_back(mask);
+        }
+}
+
+// tables for dead space detection, derived from board shape, placements and part sizes
+template <typename geometry>
+void bitboard_solver<geometry>::init_tables()
+{
+    // parts which fill a pocket exactly, size of smallest remaining part
+    pocket_parts.clear();
+    for (size_t i = 0; i < placements.size(); i++)
+        pocket_parts[placements.mask[i]] |= 1 << placements.part[i];
+    min_size.assign((size_t)2 << partcount, 0);
+    for (size_t remaining = 2; remaining < min_size.size(); remaining += 2)
+    {
+        min_size[remaining] = UINT8_MAX;
+        for (uint8_t part_number = 1; part_number <= partcount; part_number++)
+            if (remaining >> part_number & 1)
+                min_size[remaining] = min(min_size[remaining], part_size[part_number]);
+    }
+    // region sizes which can be composed of the remaining parts (sums of part sizes)
+    region_sizes.assign((size_t)2 << partcount, 1);
+    for (size_t remaining = 2; remaining < region_sizes.size(); remaining += 2)
+    {
+        uint8_t part_number = __builtin_ctzll(remaining);
+        region_sizes[remaining] = region_sizes[remaining & (remaining-1)] | region_sizes[remaining & (remaining-1)] << part_size[part_number];
+    }
+}
+
+// lookup tables for size of free region within distance 2 of each field
+template <typename geometry>
+void bitboard_solver<geometry>::init_windows()
+{
+    map <vector <array <int,3> >, uint32_t> shapes;    // window shape (offsets in bit order) -> table
+
+    window_tables.clear();
+    for (uint8_t f = 0; f < geometry::FIELDS; f++)
+    {
+        window[f] = 0;
+        for (uint8_t d = 0; d < board.DIRECTIONS; d++)
+        {
+            const int8_t* step = geometry::DIRECTIONS[d];
+            window[f] |= board.next_field[f][d];
+            for (uint8_t e = 0; e < board.DIRECTIONS; e++)
+            {
+                const int8_t* next = geometry::DIRECTIONS[e];
+                window[f] |= board.bit(board.layer[f]+step[0]+next[0], board.row[f]+step[1]+next[1], board.col[f]+step[2]+next[2]);
+            }
+        }
+        window[f] &= ~((bitboard)1 << f);
+
+        vector <array <int,3> > offset;     // offsets of window fields in bit order
+        for (bitboard mask = window[f]; mask; mask &= mask-1)
+        {
+            uint8_t i = __builtin_ctzll(mask);
+            offset.push_back({board.layer[i]-board.layer[f], board.row[i]-board.row[f], board.col[i]-board.col[f]});
+        }
+        if (!shapes.count(offset))
+        {
+            shapes[offset] = window_tables.size();
+            window_tables.resize(window_tables.size() + ((size_t)1 << offset.size()));
+            uint8_t* table = &window_tables[shapes[offset]];
+            for (size_t pattern = 0; pattern < (size_t)1 << offset.size(); pattern++)
+            {
+                // flood fill from center through free window fields
+                vector <array <int,3> > region(1, array <int,3>{0, 0, 0});
+                vector <bool> visited(offset.size(), false);
+                for (size_t r = 0; r < region.size(); r++)
+                    for (size_t i = 0; i < offset.size(); i++)
+                        for (uint8_t d = 0; d < board.DIRECTIONS && !visited[i] && !(pattern >> i & 1); d++)
+                            if (offset[i][0] - region[r][0] == geometry::DIRECTIONS[d][0] &&
+                                offset[i][1] - region[r][1] == geometry::DIRECTIONS[d][1] &&
+                                offset[i][2] - region[r][2] == geometry::DIRECTIONS[d][2])
+                            {
+                                visited[i] = true;
+                                region.push_back(offset[i]);
+                            }
+                table[pattern] = region.size();
+            }
+        }
+        window_offset[f] = shapes[offset];
+    }
+    // all tables are complete, so pointers into them remain valid
+    for (uint8_t f = 0; f < geometry::FIELDS; f++)
+        window_size[f] = window_tables.data() + window_offset[f];
+}
+
+// returns field permutation of board transformation t (bit 0: mirror rows, bit 1: mirror columns, bit 2: transpose),
+// or an empty vector if the board shape is not symmetric under t (layers are kept)
+template <typename geometry>
+vector <uint8_t> bitboard_solver<geometry>::board_symmetry(uint8_t t) const
+{
+    vector <uint8_t> perm;
+    bitboard bit;
+
+    for (uint8_t f = 0; f < geometry::FIELDS; f++)
+    {
+        int y = t & 4 ? board.col[f] : board.row[f], x = t & 4 ? board.row[f] : board.col[f];
+        if (t & 1)
+            y = geometry::ROWS-1 - y;
+        if (t & 2)
+            x = geometry::COLS-1 - x;
+        bit = board.bit(board.layer[f], y, x);
+        if (!bit)
+            return vector <uint8_t>();
+        perm.push_back(__builtin_ctzll(bit));
+    }
+    return perm;
+}
+
+template <typename geometry>
+void bitboard_solver<geometry>::init_symmetries(symmetry_mode symmetry)
+{
+    // symmetries of the board shape which map the placements of each part onto placements of the same part
+    symmetries.clear();
+    symmetric_part = 0;
+    for (uint8_t t = 1; t < 8 && symmetry != SYMMETRY_OFF; t++)
+    {
+        vector <uint8_t> perm = board_symmetry(t);
+        for (uint8_t part_number = 1; part_number <= partcount && perm.size(); part_number++)
+        {
+            unordered_set <bitboard> masks;
+            for (size_t i = table.part_begin[part_number]; i < table.part_begin[part_number+1]; i++)
+                masks.insert(table.mask[i]);
+            for (size_t i = table.part_begin[part_number]; i < table.part_begin[part_number+1] && perm.size(); i++)
+                if (!masks.count(transform(table.mask[i], perm)))
+                    perm.clear();   // orientations of part are restricted in input file
+        }
+        if (perm.size())
+            symmetries.push_back(perm);
+    }
+    for (size_t i = 0; i < table.size(); i++)
+        for (size_t t = 0; t < symmetries.size(); t++)
+            if (transform(table.mask[i], symmetries[t]) == table.mask[i])
+                table.stabilizer[i] |= 1 << t;
+
+    // restrict the part with the fewest self-symmetric placements to the first placement of each orbit
+    if (symmetry == SYMMETRY_BREAK && symmetries.size())
+    {
+        size_t fewest = SIZE_MAX;
+        for (uint8_t part_number = 1; part_number <= partcount; part_number++)
+        {
+            size_t count = 0;
+            for (size_t i = table.part_begin[part_number]; i < table.part_begin[part_number+1]; i++)
+                count += table.stabilizer[i] != 0;
+            if (count < fewest)
+            {
+                fewest = count;
+                symmetric_part = part_number;
+            }
+        }
+        unordered_set <bitboard> seen;
+        vector <bool> keep(table.size(), true);
+        for (size_t i = table.part_begin[symmetric_part]; i < table.part_begin[symmetric_part+1]; i++)
+        {
+            if (seen.count(table.mask[i]))
+            {
+                keep[i] = false;
+                continue;
+            }
+            for (size_t t = 0; t < symmetries.size(); t++)
+                seen.insert(transform(table.mask[i], symmetries[t]));
+        }
+        table.compact(keep);
+    }
+}
+
+// returns first field of mask in scan order (line by line, top/left first inside line)
+template <typename geometry>
+uint8_t bitboard_solver<geometry>::first_field(bitboard mask) const
+{
+    return kernels.first_field(scan_lines.data(), scan_lines.size(), mask);
+}
+
+// writes part numbers of the first depth placements of path into cells (0 = empty field)
+template <typename geometry>
+void bitboard_solver<geometry>::fill_board(const placement_index path[MAX_PARTS], uint8_t depth, uint8_t cells[MAX_FIELDS]) const
+{
+    bitboard mask;
+    for (uint8_t i = 0; i < geometry::FIELDS; i++)
+        cells[i] = 0;
+    for (uint8_t d = 0; d < depth; d++)
+        for (mask = placements.mask[path[d]]; mask; mask &= mask-1)
+            cells[__builtin_ctzll(mask)] = placements.part[path[d]];
+}
+
+// check for cavities (single or double spaces) at the free fields in 'check' (boards with several planes)
+// A free field is isolated if it has at most one free neighbour on each plane and
+// the only free neighbour has no further free neighbour on the same plane.
+// Only fields whose neighbourhood has changed have to be checked, because the board was free of cavities before.
+template <typename geometry>
+bool bitboard_solver<geometry>::cavity(bitboard occupied, bitboard check) const
+{
+    return kernels.cavity(board.plane_neighbours[0], board.next_field[0], board.further[0], geometry::PLANES, ~occupied & board.all, check);
+}
+
+// check if free fields next to the placed part (or all free fields) belong to a pocket which can't be filled by the remaining parts
+// (this accelerates the search significantly)
+template <typename geometry>
+dead_space_check bitboard_solver<geometry>::dead_space(bitboard occupied, bitboard placed, bitboard affected, uint16_t remaining, bool all) const
+{
+    bitboard free = ~occupied & board.all;
+    bitboard check = 0, region;
+    uint8_t field_number, smallest = min_size[remaining];
+    unsigned size;
+    bool open;
+    uint8_t limit = 2*smallest;     // smaller pockets can only be filled by a single part
+
+    if (!remaining)
+        return SPACE_OK;
+    if (geometry::PLANES > 1 && cavity(occupied, affected))
+        return SPACE_CAVITY;
+    if (all)
+        check = free;
+    else
+        for (bitboard mask = placed; mask; mask &= mask-1)
+            check |= board.neighbours[__builtin_ctzll(mask)];
+    check &= free;
+
+    while (check)
+    {
+        field_number = __builtin_ctzll(check);
+        if (geometry::WINDOW && window_size[field_number][kernels.extract(occupied, window[field_number])] >= limit)
+        {   // free region is large enough within window
+            check &= check-1;
+            continue;
+        }
+        // flood fill until region is closed or large enough
+        region = (bitboard)1 << field_number;
+        size = kernels.fill_region(board.neighbours, region, free, limit, open);
+        check &= ~region;
+        if (open)           // region is large enough
+            continue;
+        if (size < smallest)
+            return SPACE_POCKET_SMALL;  // pocket too small for any remaining part
+        unordered_map <bitboard, uint16_t>::const_iterator fill = pocket_parts.find(region);
+        if (fill == pocket_parts.end() || !(fill->second & remaining))
+            return SPACE_POCKET_FIT;    // no remaining part fits exactly into pocket
+    }
+
+    // size of each free region has to be a sum of sizes of remaining parts
+    for (check = free; check; check &= ~region)
+    {
+        region = check & (~check+1);
+        size = kernels.fill_region(board.neighbours, region, free, MAX_FIELDS+1, open);
+        if (region == free)     // single region (all free fields) always matches the remaining parts
+            break;
+        if (!(region_sizes[remaining] >> size & 1))
+            return SPACE_REGION;
+    }
+    return SPACE_OK;
+}
+
+// checks if the solution is the smallest (compared field by field) of its images under the symmetries
+// which can map it onto another solution found by the search
+template <typename geometry>
+bool bitboard_solver<geometry>::canonical(const search_state & s) const
+{
+    uint8_t cells[MAX_FIELDS], image[MAX_FIELDS];
+    uint8_t group = (1 << symmetries.size()) - 1;
+
+    for (uint8_t d = 0; d < s.depth && symmetric_part; d++)
+        if (placements.part[s.path[d]] == symmetric_part)
+            group = placements.stabilizer[s.path[d]];
+    if (!group)
+        return true;
+    fill_board(s.path, s.depth, cells);
+    for (size_t t = 0; t < symmetries.size(); t++)
+        if (group >> t & 1)
+        {
+            for (uint8_t i = 0; i < geometry::FIELDS; i++)
+                image[symmetries[t][i]] = cells[i];
+            if (lexicographical_compare(image, image + geometry::FIELDS, cells, cells + geometry::FIELDS))
+                return false;
+        }
+    return true;
+}
+
+// returns the empty field with the fewest placements of remaining parts which fit into the board
+template <typename geometry>
+uint8_t bitboard_solver<geometry>::fewest_field(const search_state & s) const
+{
+    bitboard free = ~s.occupied & board.all;
+    uint8_t field_number, best = __builtin_ctzll(free);
+    size_t count, best_count = SIZE_MAX;
+
+    for (; free && best_count > 1; free &= free-1)
+    {
+        field_number = __builtin_ctzll(free);
+        count = 0;
+        for (size_t k = covering.begin[field_number]; k < covering.begin[field_number+1] && count < best_count; k += KERNEL_BLOCK)
+            count += __builtin_popcountll(kernels.fits(covering.mask + k, covering.part + k,
+                                                       min(covering.begin[field_number+1] - k, (size_t)KERNEL_BLOCK), s.occupied, s.remaining));
+        if (count < best_count)
+        {
+            best_count = count;
+            best = field_number;
+        }
+    }
+    return best;
+}
+
+// puts part on board, calls next(s) if all checks passed, and removes part from board
+template <typename geometry>
+template <typename step>
+inline void bitboard_solver<geometry>::try_placement(search_state & s, placement_index p, step next)
+{
+    uint16_t remaining = s.remaining;
+    bitboard mask = placements.mask[p];
+    bitboard affected = geometry::PLANES > 1 ? placements.affected[p] : 0;
+    dead_space_check check;
+
+    s.tested++;
+    METRIC(s.depth, placements.part[p], METRIC_TRIED);
+    if (s.occupied & mask)              // field occupied?
+    {
+        METRIC(s.depth, placements.part[p], METRIC_OVERLAP);
+        return;
+    }
+    s.occupied |= mask;                 // put part on board
+    s.remaining ^= 1 << placements.part[p];
+    // check all free fields if size of smallest remaining part changes
+    check = dead_space(s.occupied, mask, affected, s.remaining, min_size[s.remaining] != min_size[remaining]);
+    if (check == SPACE_OK)              // all checks passed
+    {
+        METRIC(s.depth, placements.part[p], METRIC_NODES);
+        s.path[s.depth++] = p;
+        s.nodes++;
+        next(s);
+        s.depth--;
+    }
+    else
+        METRIC(s.depth, placements.part[p], (metric)(METRIC_CAVITY + check - SPACE_CAVITY));
+    s.occupied ^= mask;                 // remove part from board
+    s.remaining = remaining;
+}
+
+// tries the placements begin..end-1 (indices in list, or placement numbers without list) whose part is remaining
+// and which fit into the board, the fit test runs in blocks of KERNEL_BLOCK placements
+template <typename geometry>
+template <typename step>
+inline void bitboard_solver<geometry>::try_fitting(search_state & s, size_t begin, size_t end, const bitboard mask[],
+                                                   const uint8_t part[], const placement_index list[], step next)
+{
+    for (size_t k = begin; k < end && !s.stop; k += KERNEL_BLOCK)
+    {
+        size_t count = min(end - k, (size_t)KERNEL_BLOCK);
+        bitboard fit = kernels.fits(mask + k, part + k, count, s.occupied, s.remaining);
+        if (!list)      // (with part branching, overlapping placements count as tried)
+            s.tested += count - __builtin_popcountll(fit);
+#ifdef SEARCH_METRICS
+        for (size_t j = 0; j < count; j++)
+            if (s.remaining >> part[k+j] & 1 && !(fit >> j & 1))
+            {
+                METRIC(s.depth, part[k+j], METRIC_TRIED);
+                METRIC(s.depth, part[k+j], METRIC_OVERLAP);
+            }
+#endif
+        for (; fit && !s.stop; fit &= fit-1)
+            try_placement(s, list ? list[k + __builtin_ctzll(fit)] : k + __builtin_ctzll(fit), next);
+    }
+}
+
+// tries all placements for the next search step (next part at all positions, or remaining parts covering the selected field)
+template <typename geometry>
+template <typename step>
+void bitboard_solver<geometry>::branch(search_state & s, step next)
+{
+    bool skip = s.depth < replay;       // resumed search: start with placement of resume path
+    if (skip && s.depth+1 == replay)
+        replay = 0;                     // node of checkpoint reached
+    if (branching == BRANCH_PART)
+    {
+        uint8_t part_number = __builtin_ctz(s.remaining);
+        try_fitting(s, skip ? resume_path[s.depth] : placements.part_begin[part_number], placements.part_begin[part_number+1],
+                    placements.mask, placements.part, nullptr, next);
+    }
+    else
+    {
+        const field_view & p = branching == BRANCH_FIRST ? starting : covering;
+        uint8_t field_number = branching == BRANCH_FIRST ? first_field(~s.occupied & board.all) : fewest_field(s);
+        uint32_t k = p.begin[field_number];
+        while (skip && k < p.begin[field_number+1] && p.list[k] != resume_path[s.depth])
+            k++;
+        try_fitting(s, k, p.begin[field_number+1], p.mask, p.part, p.list, next);
+    }
+}
+
+// recursive function to perform backtracking algorithm
+template <typename geometry>
+void bitboard_solver<geometry>::find_position(search_state & s)
+{
+    branch(s, [this](search_state & s)
+    {
+        uint8_t cells[MAX_FIELDS];
+
+        if (render_request.load(memory_order_relaxed))     // visualization asks for current board?
+        {
+            fill_board(s.path, s.depth, cells);
+            render_publish(cells);
+        }
+        if (!s.remaining)                   // all parts on board? -> Heureka!
+        {
+            if (!canonical(s))              // symmetric image of another solution
+                return;
+            chrono::steady_clock::duration time = chrono::steady_clock::now() - start;
+            long seconds = chrono::duration_cast<chrono::seconds>(time).count();
+            uint64_t number = solutions_found.fetch_add(1, memory_order_relaxed) + 1;
+            if (number == 1)
+                first_time.store(chrono::duration_cast<chrono::nanoseconds>(time).count(), memory_order_relaxed);
+            if (number == nth)
+                nth_time.store(chrono::duration_cast<chrono::nanoseconds>(time).count(), memory_order_relaxed);
+            if (s.found)
+            {   // store solution in buffer of task
+                s.found->push_back(found_solution());
+                s.found->back().seconds = seconds;
+                copy(s.path, s.path + s.depth, s.found->back().path);
+            }
+            else
+                show_solution(s.path, seconds);
+        }
+        else                                // try to find position for next part -> this creates many recursions
+        {
+            if (checkpoint_interval && !s.found && s.depth <= CHECKPOINT_DEPTH
+                && chrono::steady_clock::now() - last_checkpoint >= chrono::seconds(checkpoint_interval))
+                save_checkpoint(s.path, s.depth);
+            if (s.depth < depth_limit)      // bounded search (--depth)
+                find_position(s);
+        }
+    });
+}
+
+// collects all valid combinations of placements for the next search steps until depth parts are on board, as tasks for parallel search
+template <typename geometry>
+void bitboard_solver<geometry>::collect_tasks(search_state & s, uint8_t depth, vector <search_state> & tasks)
+{
+    branch(s, [&](search_state & s)
+    {
+        if (s.depth == depth)
+        {
+            tasks.push_back(s);
+            tasks.back().nodes = tasks.back().tested = 0;   // statistics of task count from its node
+        }
+        else
+            collect_tasks(s, depth, tasks);
+    });
+}
+
+// splits search tree at first level, or at second level if there are not enough tasks to keep all threads busy
+template <typename geometry>
+vector <search_state> bitboard_solver<geometry>::split(search_state & s, unsigned threads)
+{
+    vector <search_state> tasks;
+
+    collect_tasks(s, 1, tasks);
+    if (tasks.size() < 16*threads)
+    {
+        tasks.clear();
+        s.nodes = s.tested = 0;
+        collect_tasks(s, 2, tasks);
+    }
+    return tasks;
+}
+
+// estimates the number of nodes in the subtree of s by random descents (Knuth's estimator),
+// the pseudo random numbers only depend on the seed, so the estimate is the same in each process
+template <typename geometry>
+double bitboard_solver<geometry>::estimate(const search_state & s, uint64_t seed)
+{
+    vector <placement_index> children;
+    double nodes = 0;
+
+    for (unsigned probe = 0; probe < SHARD_PROBES; probe++)
+    {
+        search_state t = s;
+        double weight = 1;
+        nodes += 1;
+        while (t.remaining)
+        {
+            children.clear();
+            branch(t, [&](search_state & c) { children.push_back(c.path[c.depth-1]); });
+            if (children.empty())
+                break;
+            weight *= children.size();
+            nodes += weight;
+            seed ^= seed << 13;     // xorshift
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            placement_index p = children[seed % children.size()];
+            t.occupied |= placements.mask[p];
+            t.remaining ^= 1 << placements.part[p];
+            t.path[t.depth++] = p;
+        }
+    }
+    return nodes / SHARD_PROBES;
+}
+
+// returns the tasks of this shard: the tasks of the search tree are split into consecutive ranges of similar estimated size
+template <typename geometry>
+vector <search_state> bitboard_solver<geometry>::shard_tasks(search_state & s)
+{
+    vector <search_state> tasks = split(s, shards), selected;
+    vector <double> size(tasks.size());
+    double total = 0, before = 0, share = 0;
+
+    for (size_t task = 0; task < tasks.size(); task++)
+        total += size[task] = estimate(tasks[task], 0x9e3779b97f4a7c15ull ^ task);
+    for (size_t task = 0; task < tasks.size(); task++)
+    {
+        // task belongs to the shard which contains the middle of its estimated size
+        if (min((unsigned)((before + size[task]/2) / total * shards), shards-1) == shard-1)
+        {
+            selected.push_back(tasks[task]);
+            share += size[task];
+        }
+        before += size[task];
+    }
+    cout<<"Shard "<<shard<<"/"<<shards<<": "<<selected.size()<<" of "<<tasks.size()<<" tasks, "
+        <<(int)(100*share/total + 0.5)<<"% of estimated search tree."<<endl;
+    return selected;
+}
+
+// drops the tasks before the node of the checkpoint (resumed search),
+// the task which contains the node is replaced by the nodes from the checkpoint on at its level
+template <typename geometry>
+void bitboard_solver<geometry>::resume_tasks(vector <search_state> & tasks)
+{
+    size_t task = 0;
+
+    while (task < tasks.size() && !equal(tasks[task].path, tasks[task].path + min(tasks[task].depth, resume_depth), resume_path))
+        task++;
+    tasks.erase(tasks.begin(), tasks.begin() + task);
+    if (tasks.size() && tasks[0].depth < resume_depth)
+    {
+        vector <search_state> nodes;
+        replay = resume_depth;
+        collect_tasks(tasks[0], resume_depth, nodes);
+        tasks.erase(tasks.begin());
+        tasks.insert(tasks.begin(), nodes.begin(), nodes.end());
+    }
+}
+
+// searches all solutions with given branching, sequentially or with given number of threads
+template <typename geometry>
+void bitboard_solver<geometry>::solve(unsigned threads, branch_mode branch)
+{
+    search_state s{};
+    vector <search_state> tasks;
+    vector <vector <found_solution> > found;
+
+    s.remaining = ((2 << partcount) - 1) & ~1;
+    branching = branch;
+    start = chrono::steady_clock::now() - chrono::seconds(resume_seconds);
+    last_checkpoint = chrono::steady_clock::now();
+    if (shards <= 1 && (threads <= 1 || partcount < 3))
+    {
+        replay = resume_depth;
+        find_position(s);
+        nodes = s.nodes;
+        tested = s.tested;
+        return;
+    }
+
+    tasks = shards > 1 ? shard_tasks(s) : split(s, threads);
+    if (resume_depth)
+        resume_tasks(tasks);
+    nodes = s.nodes;        // nodes of the levels above the tasks
+    tested = s.tested;
+    if (threads <= 1)
+    {   // shard: tasks one after the other
+        for (size_t task = 0; task < tasks.size(); task++)
+        {
+            find_position(tasks[task]);
+            nodes += tasks[task].nodes;
+            tested += tasks[task].tested;
+        }
+        return;
+    }
+    found.resize(tasks.size());
+
+    run_tasks(tasks.size(), threads,
+        [&](size_t task)
+        {
+            tasks[task].found = &found[task];
+            find_position(tasks[task]);
+        },
+        [&](size_t task)
+        {
+            for (size_t i = 0; i < found[task].size(); i++)
+                show_solution(found[task][i].path, found[task][i].seconds);
+            vector <found_solution>().swap(found[task]);   // release buffer
+            nodes += tasks[task].nodes;
+            tested += tasks[task].tested;
+            if (checkpoint_interval && task+1 < tasks.size()
+                && chrono::steady_clock::now() - last_checkpoint >= chrono::seconds(checkpoint_interval))
+                save_checkpoint(tasks[task+1].path, tasks[task+1].depth);
+        });
+}
+
+// returns the number of solutions which complete the search state
+template <typename geometry>
+uint64_t bitboard_solver<geometry>::count_completions(search_state & s, memo_table & memo)
+{
+    uint64_t n = 0;
+    uint8_t group = symmetries.size() ? UINT8_MAX : 0;     // symmetries which can reject completions as symmetric images
+
+    for (uint8_t d = 0; d < s.depth && symmetric_part && group; d++)
+        if (placements.part[s.path[d]] == symmetric_part)
+            group = placements.stabilizer[s.path[d]];
+    if (!group && memo.find(s.occupied, s.remaining, n))
+    {
+        solutions_found.fetch_add(n, memory_order_relaxed);
+        return n;
+    }
+    branch(s, [&](search_state & s)
+    {
+        if (render_request.load(memory_order_relaxed))     // visualization asks for current board?
+        {
+            uint8_t cells[MAX_FIELDS];
+            fill_board(s.path, s.depth, cells);
+            render_publish(cells);
+        }
+        if (!s.remaining)
+        {
+            if (canonical(s))
+            {
+                n++;
+                solutions_found.fetch_add(1, memory_order_relaxed);
+            }
+        }
+        else
+            n += count_completions(s, memo);
+    });
+    if (!group)
+        memo.store(s.occupied, s.remaining, n);
+    return n;
+}
+
+// counts all solutions with given branching, sequentially or with given number of threads,
+// with transposition tables of the given number of bytes (divided among the threads)
+template <typename geometry>
+uint64_t bitboard_solver<geometry>::count(unsigned threads, branch_mode branch, size_t memory)
+{
+    search_state s{};
+    vector <search_state> tasks;
+    uint64_t total = 0;
+
+    s.remaining = ((2 << partcount) - 1) & ~1;
+    branching = branch;
+    start = chrono::steady_clock::now();
+    if (shards <= 1 && (threads <= 1 || partcount < 3))
+    {
+        memo_table memo;
+        memo.init(memory);
+        total = count_completions(s, memo);
+        nodes = s.nodes;
+        tested = s.tested;
+        return total;
+    }
+
+    tasks = shards > 1 ? shard_tasks(s) : split(s, threads);
+    nodes = s.nodes;        // nodes of the levels above the tasks
+    tested = s.tested;
+    if (threads <= 1)
+    {
+        memo_table memo;
+        memo.init(memory);
+        for (size_t task = 0; task < tasks.size(); task++)
+        {
+            total += count_completions(tasks[task], memo);
+            nodes += tasks[task].nodes;
+            tested += tasks[task].tested;
+        }
+        return total;
+    }
+    vector <uint64_t> counts(tasks.size());
+    run_tasks(tasks.size(), threads,
+        [&](size_t task)
+        {
+            thread_local memo_table memo;   // one table for each worker thread
+            if (!memo.size())
+                memo.init(memory / threads);
+            counts[task] = count_completions(tasks[task], memo);
+        },
+        [&](size_t task)
+        {
+            total += counts[task];
+            nodes += tasks[task].nodes;
+            tested += tasks[task].tested;
+        });
+    return total;
+}
+
+// searches completions of a challenge into s.found, stops after limit solutions (0 = all) or at deadline
+template <typename geometry>
+void bitboard_solver<geometry>::find_completions(search_state & s, uint64_t limit, chrono::steady_clock::time_point deadline)
+{
+    branch(s, [&](search_state & s)
+    {
+        if (s.remaining)
+        {
+            if (!(s.nodes & 63) && chrono::steady_clock::now() > deadline)     // (clock is read every 64 nodes)
+                s.stop = true;
+            else
+                find_completions(s, limit, deadline);
+            return;
+        }
+        s.found->push_back(found_solution());
+        s.found->back().seconds = 0;
+        copy(s.path, s.path + s.depth, s.found->back().path);
+        if (s.found->size() == limit)
+            s.stop = true;
+    });
+}
+
+// returns placement of part with given orientation and position of its origin, or placements.size() if it doesn't fit
+template <typename geometry>
+size_t bitboard_solver<geometry>::find_placement(uint8_t part_number, int orientation, int z, int y, int x) const
+{
+    if (part_number < 1 || part_number > partcount)
+        return placements.size();
+    for (size_t p = placements.part_begin[part_number]; p < placements.part_begin[part_number+1]; p++)
+        if (placements.orientation[p] == orientation && placements.layer[p] == z && placements.row[p] == y && placements.col[p] == x)
+            return p;
+    return placements.size();
+}
+
+// puts pre-placed part on board of challenge, returns false (with error) if the part is already on board or overlaps
+template <typename geometry>
+bool bitboard_solver<geometry>::place(challenge & c, placement_index p) const
+{
+    if (!(c.start.remaining >> placements.part[p] & 1))
+        c.error = string("part ") + (char)(placements.part[p]+64) + " is placed twice";
+    else if (c.start.occupied & placements.mask[p])
+        c.error = string("part ") + (char)(placements.part[p]+64) + " overlaps another part";
+    else
+    {
+        c.start.occupied |= placements.mask[p];
+        c.start.remaining ^= 1 << placements.part[p];
+        c.start.path[c.start.depth++] = p;
+        return true;
+    }
+    return false;
+}
+
+// parses one challenge: grid lines in the layout of the log file ('.' = empty field, A,B,C,... = part,
+// with hints: a,b,c,... = field covered by part) and placement lines "part orientation [layer] row col"
+// (orientation in order of the input file, all numbers from 0)
+template <typename geometry>
+challenge bitboard_solver<geometry>::parse_challenge(const vector <string> & lines, unsigned first_line, bool hints) const
+{
+    challenge c = {};
+    bitboard part_mask[MAX_PARTS] = {};
+    vector <pair <int, int> > rows;     // layer and row of each grid line
+    size_t grid = 0;
+
+    c.start.remaining = ((2 << partcount) - 1) & ~1;
+    c.line = first_line;
+    for (int z = 0; z < geometry::LAYERS; z++)
+        for (int y = 0; y < geometry::ROWS; y++)
+            for (int x = 0; x < geometry::COLS; x++)
+                if (board.field[z][y][x] >= 0)
+                {
+                    rows.push_back(make_pair(z, y));
+                    break;
+                }
+
+    for (size_t l = 0; l < lines.size() && c.error.empty(); l++)
+    {
+        const string & line = lines[l];
+        string where = "line " + to_string(first_line + l) + ": ";
+        if (line.size() > 1 && line[0] >= 'A' && line[0] < 'A'+partcount && (line[1] == ' ' || line[1] == '\t'))
+        {   // placement of part
+            istringstream in(line.substr(1));
+            int orientation, z = 0, y, x;
+            uint8_t part_number = line[0]-64;
+            size_t p;
+            string rest;
+            in >> orientation;
+            if (geometry::DIMENSIONS > 2)
+                in >> z;
+            in >> y >> x;
+            if (in.fail() || (in >> rest))
+            {
+                c.error = where + "expected part, orientation" + (geometry::DIMENSIONS > 2 ? ", layer" : "") + ", row and column";
+                break;
+            }
+            p = find_placement(part_number, orientation, z, y, x);
+            if (p == placements.size())
+                c.error = where + "part " + line[0] + " does not fit into the board at this position";
+            else if (!place(c, p))
+                c.error = where + c.error;
+            continue;
+        }
+        // grid line: one character for each field, margin as in log file
+        if (grid == rows.size())
+        {
+            c.error = where + "too many grid lines";
+            break;
+        }
+        size_t pos = 0;
+        int z = rows[grid].first, y = rows[grid].second;
+        for (int x = 0; x < geometry::COLS && c.error.empty(); x++)
+        {
+            if (board.field[z][y][x] < 0)
+            {
+                pos += geometry::MARGIN != 0;
+                continue;
+            }
+            char ch = pos < line.size() ? line[pos] : 0;
+            pos++;
+            if (ch >= 'A' && ch < 'A'+partcount)
+                part_mask[ch-64] |= (bitboard)1 << board.field[z][y][x];
+            else if (hints && ch >= 'a' && ch < 'a'+partcount)
+                c.hints[ch-96] |= (bitboard)1 << board.field[z][y][x];
+            else if (ch != '.')
+                c.error = where + (ch ? string("invalid character '") + ch + "' at column " + to_string(pos) : string("line too short"));
+        }
+        if (c.error.empty() && line.find_first_not_of(" \t\r", pos) != string::npos)
+            c.error = where + "line too long";
+        grid++;
+    }
+    if (c.error.empty() && grid && grid < rows.size())
+        c.error = "line " + to_string(first_line) + ": grid has " + to_string(grid) + " of " + to_string(rows.size()) + " lines";
+    // parts of the grid have to match a placement exactly
+    for (uint8_t part_number = 1; part_number <= partcount && c.error.empty(); part_number++)
+        if (part_mask[part_number])
+        {
+            size_t p = placements.part_begin[part_number];
+            while (p < placements.part_begin[part_number+1] && placements.mask[p] != part_mask[part_number])
+                p++;
+            if (p == placements.part_begin[part_number+1])
+                c.error = string("part ") + (char)(part_number+64) + " of the grid does not match any orientation";
+            else if (!place(c, p))
+                c.error = "line " + to_string(first_line) + ": " + c.error;
+        }
+    return c;
+}
+
+// reads all challenges of a file (separated by empty lines, lines starting with // are ignored)
+template <typename geometry>
+vector <challenge> bitboard_solver<geometry>::read_challenges(const string & filename, bool hints) const
+{
+    ifstream file(filename);
+    vector <challenge> challenges;
+    vector <string> lines;
+    string line;
+    unsigned number = 0, first_line = 0;
+
+    while (true)
+    {
+        bool end = !getline(file, line);
+        number++;
+        size_t text = end ? string::npos : line.find_first_not_of(" \t\r");
+        if (text != string::npos && line.compare(text, 2, "//") == 0)
+            continue;
+        if (text == string::npos)
+        {   // empty line or end of file: challenge is complete
+            if (lines.size())
+                challenges.push_back(parse_challenge(lines, first_line, hints));
+            lines.clear();
+            if (end)
+                break;
+            continue;
+        }
+        if (lines.empty())
+            first_line = number;
+        lines.push_back(line);
+    }
+    return challenges;
+}
+
+// prints throughput and latency of the valid challenges (in us)
+inline void show_latency(const vector <challenge> & challenges, const vector <double> & latency, size_t solved, size_t valid,
+                         chrono::steady_clock::duration time)
+{
+    double seconds = chrono::duration_cast<chrono::microseconds>(time).count() / 1e6;
+    vector <double> sorted;
+
+    for (size_t n = 0; n < challenges.size(); n++)
+        if (challenges[n].error.empty())
+            sorted.push_back(latency[n]);
+    sort(sorted.begin(), sorted.end());
+    cout<<challenges.size()<<" challenges ("<<challenges.size()-valid<<" invalid), "<<solved<<" solved in "<<seconds<<"s ("
+        <<(uint64_t)(challenges.size() / (seconds > 0 ? seconds : 1))<<" challenges/s)."<<endl;
+    if (sorted.size())
+    {
+        double sum = 0;
+        for (size_t n = 0; n < sorted.size(); n++)
+            sum += sorted[n];
+        cout<<"Latency per challenge: mean "<<(uint64_t)(sum / sorted.size())<<"us, median "<<(uint64_t)sorted[sorted.size()/2]
+            <<"us, 99% "<<(uint64_t)sorted[sorted.size()*99/100]<<"us, max "<<(uint64_t)sorted.back()<<"us."<<endl;
+    }
+}
+
+// solves challenges sequentially or as parallel tasks, writes results in order of the challenges,
+// prints throughput and latency, returns number of challenges with solutions
+template <typename geometry>
+size_t bitboard_solver<geometry>::solve_challenges(const vector <challenge> & challenges, unsigned threads, branch_mode branch,
+                                                   uint64_t limit, ostream & out)
+{
+    vector <vector <found_solution> > found(challenges.size());
+    vector <double> latency(challenges.size(), 0);     // search time of each challenge in us
+    size_t solved = 0, valid = 0;
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+
+    branching = branch;
+    function <void(size_t)> work = [&](size_t n)
+    {
+        chrono::steady_clock::time_point t = chrono::steady_clock::now();
+        search_state s = challenges[n].start;
+        if (challenges[n].error.size())
+            return;
+        s.found = &found[n];
+        if (!s.remaining)
+        {   // all parts pre-placed
+            found[n].push_back(found_solution());
+            copy(s.path, s.path + s.depth, found[n].back().path);
+        }
+        else if (dead_space(s.occupied, 0, board.all, s.remaining, true) == SPACE_OK)
+            find_completions(s, limit, chrono::steady_clock::time_point::max());
+        latency[n] = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - t).count() / 1000.0;
+    };
+    function <void(size_t)> merge = [&](size_t n)
+    {
+        out<<"Challenge "<<n+1<<" (line "<<challenges[n].line<<"): ";
+        if (challenges[n].error.size())
+            out<<"invalid, "<<challenges[n].error<<"\n\n";
+        else
+        {
+            out<<found[n].size()<<(found[n].size() == 1 ? " solution (" : " solutions (")<<(uint64_t)latency[n]<<"us)\n";
+            for (size_t i = 0; i < found[n].size(); i++)
+                write_solution(out, found[n][i].path, i+1, 0);
+            if (found[n].empty())
+                out<<"\n";
+            solved += found[n].size() > 0;
+            valid++;
+        }
+        solutions_found.fetch_add(found[n].size(), memory_order_relaxed);
+        vector <found_solution>().swap(found[n]);       // release buffer
+    };
+    if (threads <= 1)
+        for (size_t n = 0; n < challenges.size(); n++)
+        {
+            work(n);
+            merge(n);
+        }
+    else
+        run_tasks(challenges.size(), threads, work, merge);
+
+    show_latency(challenges, latency, solved, valid, chrono::steady_clock::now() - begin);
+    return solved;
+}
+
+template <typename geometry>
+void bitboard_solver<geometry>::set_branching(branch_mode branch)
+{
+    branching = branch;
+}
+
+// appends answer header without solutions to reply of the daemon
+inline void reply_status(vector <uint8_t> & reply, uint32_t id, answer_status status, uint8_t partcount, uint32_t time)
+{
+    answer a = {id, (uint8_t)status, partcount, 0, time};
+    reply.insert(reply.end(), (const uint8_t *)&a, (const uint8_t *)&a + sizeof(a));
+}
+
+// solves a query of the daemon (pre-placed parts, solution limit and time budget from receipt), appends answer to reply
+template <typename geometry>
+void bitboard_solver<geometry>::answer_query(const query & q, const query_placement parts[], chrono::steady_clock::time_point received,
+                                             vector <uint8_t> & reply)
+{
+    chrono::steady_clock::time_point deadline = q.budget ? received + chrono::microseconds(q.budget) : chrono::steady_clock::time_point::max();
+    uint64_t limit = q.limit ? q.limit : UINT16_MAX;
+    vector <found_solution> found;
+    challenge c = {};
+
+    c.start.remaining = ((2 << partcount) - 1) & ~1;
+    if (q.count > SERVER_MAX_PARTS || q.count > partcount)
+    {
+        reply_status(reply, q.id, ANSWER_INVALID, partcount, 0);
+        return;
+    }
+    for (uint8_t i = 0; i < q.count; i++)
+    {
+        size_t p = find_placement(parts[i].part, parts[i].orientation, parts[i].layer, parts[i].row, parts[i].col);
+        if (p == placements.size() || !place(c, p))
+        {
+            reply_status(reply, q.id, ANSWER_INVALID, partcount, 0);
+            return;
+        }
+    }
+
+    search_state & s = c.start;
+    s.found = &found;
+    if (!s.remaining)
+    {   // all parts pre-placed
+        found.push_back(found_solution());
+        copy(s.path, s.path + s.depth, found.back().path);
+    }
+    else if (dead_space(s.occupied, 0, board.all, s.remaining, true) == SPACE_OK)
+        find_completions(s, limit, deadline);
+
+    answer a = {q.id, ANSWER_COMPLETE, partcount, (uint16_t)found.size(),
+                (uint32_t)chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - received).count()};
+    if (s.stop)
+        a.status = found.size() == limit ? ANSWER_LIMIT : ANSWER_TIMEOUT;
+    reply.insert(reply.end(), (const uint8_t *)&a, (const uint8_t *)&a + sizeof(a));
+    for (size_t i = 0; i < found.size(); i++)
+        for (uint8_t d = 0; d < partcount; d++)
+        {
+            placement_index p = found[i].path[d];
+            query_placement placed = {placements.part[p], placements.orientation[p], placements.layer[p], placements.row[p], placements.col[p]};
+            reply.insert(reply.end(), (const uint8_t *)&placed, (const uint8_t *)&placed + sizeof(placed));
+        }
+}
+
+// flushes solution file and saves node with given path as checkpoint
+template <typename geometry>
+void bitboard_solver<geometry>::save_checkpoint(const placement_index path[MAX_PARTS], uint8_t depth)
+{
+    checkpoint point = {};
+
+    strncpy(point.board, geometry::NAME, sizeof(point.board));
+    point.symmetry = symmetry;
+    point.branch = branching;
+    point.output = binary ? OUTPUT_BINARY : OUTPUT_TEXT;
+    point.depth = depth;
+    point.hash = hash();
+    point.solutions = solutions;
+    if (binary)
+        point.offset = binaryfile.flush();
+    else
+        point.offset = logfile.flush().tellp();
+    point.seconds = chrono::duration_cast<chrono::seconds>(chrono::steady_clock::now() - start).count();
+    for (uint8_t d = 0; d < depth; d++)
+        point.level[d] = {placements.part[path[d]], placements.orientation[path[d]],
+                          placements.layer[path[d]], placements.row[path[d]], placements.col[path[d]]};
+    write_checkpoint(checkpointfile, point);
+    last_checkpoint = chrono::steady_clock::now();
+}
+
+// all parts on board? -> Heureka!
+template <typename geometry>
+void bitboard_solver<geometry>::show_solution(const placement_index path[MAX_PARTS], long seconds)
+{
+    uint8_t code[MAX_CODE];
+
+    solutions++;
+    if (binary)
+        binaryfile.add(code, encode(path, code), seconds);
+    else
+        write_solution(logfile, path, solutions, seconds);
+}
+
+// encodes a solution: fields are covered in scan order, the placement of the solution which covers the first free field
+// is stored as its rank among all fitting placements of the remaining parts which start at this field
+// (ceil(log2(number of fitting placements)) bits, lowest bit first), returns length of code in bytes
+template <typename geometry>
+uint8_t bitboard_solver<geometry>::encode(const placement_index path[MAX_PARTS], uint8_t code[MAX_CODE]) const
+{
+    bitboard occupied = 0;
+    uint16_t remaining = ((2 << partcount) - 1) & ~1;
+    uint32_t bits = 0;
+
+    fill(code, code + MAX_CODE, 0);
+    for (uint8_t step = 0; step < partcount; step++)
+    {
+        uint8_t field_number = first_field(~occupied & board.all);
+        placement_index chosen = path[0];
+        uint32_t count = 0, rank = 0;
+        for (uint8_t d = 0; d < partcount; d++)
+            if (placements.mask[path[d]] >> field_number & 1)
+                chosen = path[d];
+        for (uint32_t k = starting.begin[field_number]; k < starting.begin[field_number+1]; k++)
+            if (remaining >> starting.part[k] & 1 && !(occupied & starting.mask[k]))
+            {
+                if (starting.list[k] == chosen)
+                    rank = count;
+                count++;
+            }
+        for (uint32_t width = count > 1 ? 32 - __builtin_clz(count-1) : 0; width; width--, rank >>= 1, bits++)
+            code[bits >> 3] |= (rank & 1) << (bits & 7);
+        occupied |= placements.mask[chosen];
+        remaining &= ~(1 << placements.part[chosen]);
+    }
+    return (bits + 7) / 8;
+}
+
+// decodes a solution into path (in scan order), returns false if the code doesn't fit to the placement table
+template <typename geometry>
+bool bitboard_solver<geometry>::decode(const uint8_t code[], uint8_t length, placement_index path[MAX_PARTS]) const
+{
+    bitboard occupied = 0;
+    uint16_t remaining = ((2 << partcount) - 1) & ~1;
+    uint32_t bits = 0;
+
+    for (uint8_t step = 0; step < partcount; step++)
+    {
+        uint8_t field_number = first_field(~occupied & board.all);
+        uint32_t count = 0, rank = 0;
+        for (uint32_t k = starting.begin[field_number]; k < starting.begin[field_number+1]; k++)
+            count += remaining >> starting.part[k] & 1 && !(occupied & starting.mask[k]);
+        for (uint32_t width = count > 1 ? 32 - __builtin_clz(count-1) : 0, i = 0; i < width; i++, bits++)
+        {
+            if (bits >= 8*length)
+                return false;
+            rank |= (uint32_t)(code[bits >> 3] >> (bits & 7) & 1) << i;
+        }
+        if (rank >= count)
+            return false;
+        for (uint32_t k = starting.begin[field_number]; ; k++)
+            if (remaining >> starting.part[k] & 1 && !(occupied & starting.mask[k]) && !rank--)
+            {
+                path[step] = starting.list[k];
+                break;
+            }
+        occupied |= placements.mask[path[step]];
+        remaining &= ~(1 << placements.part[path[step]]);
+    }
+    return (bits + 7) / 8 == length;
+}
+
+// writes solution and time stamp as text, one line for each row of each layer
+template <typename geometry>
+void bitboard_solver<geometry>::write_solution(ostream & out, const placement_index path[MAX_PARTS], uint64_t number, long seconds) const
+{
+    uint8_t cells[MAX_FIELDS];
+    string text = "Solution " + to_string(number) + " (" + to_string(seconds) + "s)\n";
+
+    fill_board(path, partcount, cells);
+    for (int z = 0; z < geometry::LAYERS; z++)
+        for (int y = 0; y < geometry::ROWS; y++)
+        {
+            string line;
+            bool fields = false;
+            for (int x = 0; x < geometry::COLS; x++)
+                if (board.field[z][y][x] >= 0)
+                {
+                    line += (char)(cells[board.field[z][y][x]]+64);     // convert 1 to A, 2 to B, ... , 12 to L
+                    fields = true;
+                }
+                else if (geometry::MARGIN)
+                    line += geometry::MARGIN;                           // margin as empty spaces
+            if (fields)
+                text += line + "\n";
+        }
+    out<<text<<"\n";     // no flush for each solution
+}
+
+// prints solution n (1-based) of binary solution file, or converts all solutions to log file if n = 0
+template <typename geometry>
+int convert_solutions(const bitboard_solver <geometry> & puzzle, solution_reader & reader, const solution_header & header,
+                      uint64_t n, const string & outputfile)
+{
+    placement_index path[MAX_PARTS];
+    const uint8_t * code;
+    uint8_t length;
+    uint32_t seconds;
+    uint64_t count = 0;
+
+    if (header.hash != puzzle.hash() || header.partcount != puzzle.partcount)
+    {
+        cout<<"Solution file does not match the placements of the input file."<<endl;
+        return 0;
+    }
+    if (n)
+    {
+        if (!(code = reader.get(n-1, length, seconds)) || !puzzle.decode(code, length, path))
+        {
+            cout<<"Solution "<<n<<" not found ("<<header.solutions<<" solutions)."<<endl;
+            return 0;
+        }
+        puzzle.write_solution(cout, path, n, seconds);
+        return 1;
+    }
+    ofstream logfile(outputfile);
+    while ((code = reader.next(length, seconds)) && puzzle.decode(code, length, path))
+        puzzle.write_solution(logfile, path, ++count, seconds);
+    logfile.close();
+    if (count != header.solutions)
+        cout<<"Solution file is corrupt after solution "<<count<<"."<<endl;
+    cout<<count<<" solutions converted to "<<outputfile<<"."<<endl;
+    return count;
+}
+
+// builds the solution index of a binary solution file: one set of solutions for each placement and for each field and part
+template <typename geometry>
+int build_index(const bitboard_solver <geometry> & puzzle, solution_reader & reader, const solution_header & header,
+                const string & indexfile)
+{
+    placement_index path[MAX_PARTS];
+    const uint8_t * code;
+    uint8_t length;
+    uint32_t seconds;
+    uint64_t count = 0;
+    index_writer index;
+    index_header h = {};
+
+    if (header.hash != puzzle.hash() || header.partcount != puzzle.partcount)
+    {
+        cout<<"Solution file does not match the placements of the input file."<<endl;
+        return 0;
+    }
+    // symmetric images of the solutions are found by mapping the challenge, which needs all placements
+    if (puzzle.symmetric_part)
+    {
+        cout<<"Solution file has a restricted part, index needs a solution file written with --symmetry dedup or off."<<endl;
+        return 0;
+    }
+    index.init(puzzle.placements.size() + geometry::FIELDS * puzzle.partcount);
+    while ((code = reader.next(length, seconds)) && puzzle.decode(code, length, path))
+    {
+        for (uint8_t d = 0; d < puzzle.partcount; d++)
+        {
+            placement_index p = path[d];
+            index.add(p, count);
+            for (bitboard fields = puzzle.placements.mask[p]; fields; fields &= fields-1)
+                index.add(puzzle.placements.size() + __builtin_ctzll(fields) * puzzle.partcount + puzzle.placements.part[p]-1, count);
+        }
+        count++;
+    }
+    if (count != header.solutions)
+    {
+        cout<<"Solution file is corrupt after solution "<<count<<"."<<endl;
+        return 0;
+    }
+    strncpy(h.board, geometry::NAME, sizeof(h.board));
+    h.symmetry = header.symmetry;
+    h.partcount = puzzle.partcount;
+    h.fields = geometry::FIELDS;
+    h.hash = header.hash;
+    h.solutions = count;
+    h.placements = puzzle.placements.size();
+    if (!index.write(indexfile, h))
+    {
+        cout<<"Can't write "<<indexfile<<"."<<endl;
+        return 0;
+    }
+    cout<<count<<" solutions indexed in "<<indexfile<<" ("<<h.size / 1024<<" kB)."<<endl;
+    return count;
+}
+
+// answers the challenges of file opt.lookup from the solution index: the solutions of the binary solution file
+// and their symmetric images which contain the pre-placed parts and cover the hinted fields with their parts,
+// results are written to a log file named after the challenge file (with --exists only whether a solution exists)
+template <typename geometry>
+int lookup_challenges(const bitboard_solver <geometry> & puzzle, solution_reader & reader, const solution_header & header,
+                      const string & indexfile, const options & opt)
+{
+    size_t slash = opt.lookup.rfind('/'), dot = opt.lookup.rfind('.');
+    string outputfile = (dot != string::npos && (slash == string::npos || dot > slash) ? opt.lookup.substr(0, dot) : opt.lookup)
+                        + "_" + geometry::NAME + geometry::OUTPUT;
+    const placement_view & placements = puzzle.placements;
+    index_reader index;
+    const index_header * h = index.open(indexfile);
+    ifstream test(opt.lookup);
+    ofstream out;
+
+    if (!h)
+    {
+        cout<<"Can't read "<<indexfile<<" (build it with --index)."<<endl;
+        return 0;
+    }
+    if (header.hash != puzzle.hash() || h->hash != header.hash || h->solutions != header.solutions
+        || strncmp(h->board, geometry::NAME, sizeof(h->board)))
+    {
+        cout<<"Index does not match the solution file and the placements of the input file (rebuild it with --index)."<<endl;
+        return 0;
+    }
+    if (!test)
+    {
+        cout<<"Can't read "<<opt.lookup<<"."<<endl;
+        return 0;
+    }
+    test.close();
+
+    // image of each placement under each symmetry (0 = identity) and the inverse images
+    size_t group = puzzle.symmetries.size() + 1;
+    vector <vector <placement_index> > image(group, vector <placement_index> (placements.size())), inverse = image;
+    unordered_map <bitboard, placement_index> by_mask[MAX_PARTS];
+    for (size_t p = 0; p < placements.size(); p++)
+        by_mask[placements.part[p]][placements.mask[p]] = p;
+    for (size_t g = 0; g < group; g++)
+        for (size_t p = 0; p < placements.size(); p++)
+        {
+            image[g][p] = g ? by_mask[placements.part[p]][transform(placements.mask[p], puzzle.symmetries[g-1])] : p;
+            inverse[g][image[g][p]] = p;
+        }
+
+    vector <challenge> challenges = puzzle.read_challenges(opt.lookup, true);
+    vector <double> latency(challenges.size(), 0);
+    size_t solved = 0, valid = 0;
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+
+    out.open(outputfile);
+    if (!out)
+    {
+        cout<<"Can't write "<<outputfile<<"."<<endl;
+        return 0;
+    }
+    for (size_t n = 0; n < challenges.size(); n++)
+    {
+        const challenge & c = challenges[n];
+        chrono::steady_clock::time_point t = chrono::steady_clock::now();
+        vector <uint64_t> found;            // numbers of solutions in file
+        vector <size_t> symmetry;           // symmetry which maps each solution to the solution of the challenge
+        uint64_t total = 0;
+        uint32_t sets[INDEX_MAX_SETS];
+        size_t count;
+
+        out<<"Challenge "<<n+1<<" (line "<<c.line<<"): ";
+        if (c.error.size())
+        {
+            out<<"invalid, "<<c.error<<"\n\n";
+            continue;
+        }
+        // a solution in the file is the image of a solution of the challenge, if it is consistent with the image of the challenge
+        for (size_t g = 0; g < group && !(opt.exists && total); g++)
+        {
+            count = 0;
+            for (uint8_t d = 0; d < c.start.depth; d++)
+                sets[count++] = image[g][c.start.path[d]];
+            for (uint8_t part_number = 1; part_number <= puzzle.partcount; part_number++)
+                for (bitboard fields = g ? transform(c.hints[part_number], puzzle.symmetries[g-1]) : c.hints[part_number];
+                     fields && count < INDEX_MAX_SETS; fields &= fields-1)
+                    sets[count++] = placements.size() + __builtin_ctzll(fields) * puzzle.partcount + part_number-1;
+            if (opt.exists)
+            {
+                total += index.any(sets, count);
+                continue;
+            }
+            total += index.intersect(sets, count, opt.limit, found);
+            symmetry.resize(found.size(), g);
+        }
+        latency[n] = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - t).count() / 1000.0;
+        valid++;
+        solved += total > 0;
+        if (opt.exists)
+        {
+            out<<(total ? "solvable (" : "not solvable (")<<(uint64_t)latency[n]<<"us)\n\n";
+            continue;
+        }
+        out<<total<<(total == 1 ? " solution (" : " solutions (")<<(uint64_t)latency[n]<<"us)\n";
+        for (size_t i = 0; i < found.size(); i++)
+        {
+            placement_index path[MAX_PARTS];
+            const uint8_t * code;
+            uint8_t length;
+            uint32_t seconds;
+            if (!(code = reader.get(found[i], length, seconds)) || !puzzle.decode(code, length, path))
+            {
+                cout<<"Solution file is corrupt at solution "<<found[i]+1<<"."<<endl;
+                return 0;
+            }
+            for (uint8_t d = 0; d < puzzle.partcount; d++)
+                path[d] = inverse[symmetry[i]][path[d]];
+            puzzle.write_solution(out, path, i+1, 0);
+        }
+        if (found.empty())
+            out<<"\n";
+    }
+    out.close();
+    show_latency(challenges, latency, solved, valid, chrono::steady_clock::now() - begin);
+    cout<<"Results written to "<<outputfile<<"."<<endl;
+    return solved;
+}
+
+// name of solution files of a shard
+inline string shard_name(const string & board, unsigned shard, unsigned shards)
+{
+    return board + "_" + to_string(shard) + "of" + to_string(shards);
+}
+
+// concatenates solution files of all shards (in order of shards) into one solution file with renumbered solutions
+template <typename geometry>
+int merge_shards(const string & board, unsigned shards, bool binary)
+{
+    string outputfile = board + (binary ? geometry::BINARY : geometry::OUTPUT);
+    uint64_t count = 0;
+
+    if (binary)
+    {
+        vector <solution_reader> reader(shards);
+        solution_writer out;
+        const solution_header * first = nullptr;
+        const uint8_t * code;
+        uint8_t length;
+        uint32_t seconds;
+
+        for (unsigned shard = 1; shard <= shards; shard++)
+        {
+            string shardfile = shard_name(board, shard, shards) + geometry::BINARY;
+            const solution_header * header = reader[shard-1].open(shardfile);
+            if (!header)
+            {
+                cout<<"Can't read "<<shardfile<<"."<<endl;
+                return 0;
+            }
+            if (!first)
+                first = header;
+            else if (header->hash != first->hash || header->symmetry != first->symmetry)
+            {
+                cout<<shardfile<<" was searched with different placements."<<endl;
+                return 0;
+            }
+        }
+        out.open(outputfile, *first);
+        for (unsigned shard = 1; shard <= shards; shard++)
+            while ((code = reader[shard-1].next(length, seconds)))
+            {
+                out.add(code, length, seconds);
+                count++;
+            }
+        out.close();
+    }
+    else
+    {
+        ofstream out(outputfile);
+        string line;
+
+        for (unsigned shard = 1; shard <= shards; shard++)
+        {
+            string shardfile = shard_name(board, shard, shards) + geometry::OUTPUT;
+            ifstream in(shardfile);
+            if (!in)
+            {
+                cout<<"Can't read "<<shardfile<<"."<<endl;
+                return 0;
+            }
+            while (getline(in, line))
+            {
+                if (!line.compare(0, 9, "Solution ") && line.find(" (") != string::npos)
+                    line = "Solution " + to_string(++count) + line.substr(line.find(" ("));
+                out<<line<<"\n";
+            }
+        }
+        out.close();
+    }
+    cout<<count<<" solutions of "<<shards<<" shards merged into "<<outputfile<<"."<<endl;
+    return count;
+}
+
+// front end of the solvers: reads parts, searches all solutions and logs them
+// solves the challenges of file opt.challenge, results are written to a log file named after the challenge file
+template <typename geometry>
+int solve_challenges(bitboard_solver <geometry> & puzzle, const options & opt)
+{
+    size_t slash = opt.challenge.rfind('/'), dot = opt.challenge.rfind('.');
+    string outputfile = (dot != string::npos && (slash == string::npos || dot > slash) ? opt.challenge.substr(0, dot) : opt.challenge)
+                        + "_" + geometry::NAME + geometry::OUTPUT;
+    ifstream test(opt.challenge);
+    ofstream out;
+
+    if (!test)
+    {
+        cout<<"Can't read "<<opt.challenge<<"."<<endl;
+        return 0;
+    }
+    test.close();
+    vector <challenge> challenges = puzzle.read_challenges(opt.challenge);
+    out.open(outputfile);
+    if (!out)
+    {
+        cout<<"Can't write "<<outputfile<<"."<<endl;
+        return 0;
+    }
+    size_t solved = puzzle.solve_challenges(challenges, opt.threads, opt.branch, opt.limit, out);
+    out.close();
+    cout<<"Results written to "<<outputfile<<"."<<endl;
+    return solved;
+}
+
+// daemon: answers challenge queries on Unix socket opt.serve for the piece sets opt.name and opt.sets
+// (placement tables without symmetry reduction), returns number of queries answered
+template <typename geometry>
+int serve_queries(bitboard_solver <geometry> & puzzle, const options & opt)
+{
+    vector <unique_ptr <bitboard_solver <geometry> > > sets;
+
+    puzzle.set_branching(opt.branch);
+    for (size_t i = 0; i < opt.sets.size(); i++)
+    {
+        string inputfile = opt.sets[i] + geometry::INPUT;
+        string cachefile = opt.sets[i] + "_" + geometry::NAME + geometry::CACHE;
+        shape_table shapes;
+
+        bool builtin = builtin_shapes(opt.sets[i], geometry::DIMENSIONS, shapes);
+
+        sets.emplace_back(new bitboard_solver <geometry>());
+        if (sets.back()->load(cachefile, builtin ? BUILTIN_SOURCE : inputfile, SYMMETRY_OFF))
+            cout<<to_string(sets.back()->partcount)<<" Parts loaded from "<<cachefile<<"."<<endl;
+        else
+        {
+            if (builtin)
+                cout<<to_string(shapes.partcount)<<" Parts of built-in set "<<opt.sets[i]<<" loaded."<<endl;
+            else
+                cout<<to_string(read_input(inputfile, shapes, geometry::DIMENSIONS))<<" Parts loaded from "<<inputfile<<"."<<endl;
+            if (shapes.partcount >= MAX_PARTS)
+            {
+                cout<<"Too many parts (at most "<<MAX_PARTS-1<<")."<<endl;
+                return 0;
+            }
+            sets.back()->init(shapes, SYMMETRY_OFF);
+        }
+        sets.back()->set_branching(opt.branch);
+    }
+    return run_server(opt.serve, opt.threads, [&](const query & q, const query_placement parts[],
+                                                  chrono::steady_clock::time_point received, vector <uint8_t> & reply)
+    {
+        if (q.set == 0)
+            puzzle.answer_query(q, parts, received, reply);
+        else if (q.set <= sets.size())
+            sets[q.set-1]->answer_query(q, parts, received, reply);
+        else
+            reply_status(reply, q.id, ANSWER_INVALID, 0, 0);
+    });
+}
+
+// prints statistics of the search as one line of key=value pairs (read by bench/bench.sh), times in ms (-1 = not reached)
+template <typename geometry>
+void show_statistics(const bitboard_solver <geometry> & puzzle, uint64_t solutions, chrono::steady_clock::duration time)
+{
+    double ms = chrono::duration_cast<chrono::microseconds>(time).count() / 1000.0;
+    double seconds = ms > 0 ? ms / 1000 : 1;
+
+    cout<<fixed<<setprecision(3)<<"stats nodes="<<puzzle.nodes<<" tested="<<puzzle.tested<<" solutions="<<solutions
+        <<" nodes_per_s="<<(uint64_t)(puzzle.nodes / seconds)<<" tested_per_s="<<(uint64_t)(puzzle.tested / seconds)
+        <<" first_ms="<<(puzzle.first_time < 0 ? -1 : puzzle.first_time / 1e6)
+        <<" nth="<<puzzle.nth<<" nth_ms="<<(puzzle.nth_time < 0 ? -1 : puzzle.nth_time / 1e6)
+        <<" total_ms="<<ms<<" kernels="<<kernels.name<<endl;
+}
+
+template <typename geometry>
+int run_solver(int argc, char *argv[])
+{
+    bitboard_solver <geometry> puzzle;
+    shape_table shapes;     // part shapes incl. all possible orientations
+    struct winsize w;   // terminal size
+    bool opened = true;
+
+    options opt = read_options(argc, argv);
+    if (!select_kernels(opt.cpu))
+    {
+        cout<<"The CPU doesn't support the search kernels of --cpu."<<endl;
+        return 0;
+    }
+    string inputfile = opt.name + geometry::INPUT;
+    string board = opt.name + "_" + geometry::NAME;
+    string shardname = opt.shards > 1 ? shard_name(board, opt.shard, opt.shards) : board;
+    string outputfile = shardname + geometry::OUTPUT;
+    string binaryfile = shardname + geometry::BINARY;
+    string indexfile = shardname + geometry::INDEX;
+    string cachefile = board + geometry::CACHE;
+    string checkpointfile = shardname + ".ckp";
+    checkpoint point;           // checkpoint of interrupted search
+    solution_reader reader;     // binary solution file to be converted
+    const solution_header * header = nullptr;
+
+    if (opt.merge)
+        return merge_shards <geometry> (board, opt.merge, opt.output == OUTPUT_BINARY);
+#ifndef SEARCH_METRICS
+    if (opt.metrics.size())
+    {
+        cout<<"Metrics are not compiled in (make -B SEARCH_METRICS=1)."<<endl;
+        return 0;
+    }
+#endif
+
+    // placement indices of binary solution file refer to placement table with symmetry mode of the file
+    if (opt.convert || opt.solution || opt.index || opt.lookup.size())
+    {
+        header = reader.open(binaryfile);
+        if (!header || strncmp(header->board, geometry::NAME, sizeof(header->board)))
+        {
+            cout<<"Can't read "<<binaryfile<<"."<<endl;
+            return 0;
+        }
+        opt.symmetry = (symmetry_mode)header->symmetry;
+    }
+    // pre-placed parts of challenges break the symmetry of the board
+    if (opt.challenge.size() || opt.serve.size())
+        opt.symmetry = SYMMETRY_OFF;
+    // resumed search continues with the settings of the interrupted search
+    if (opt.resume)
+    {
+        if (!read_checkpoint(checkpointfile, point) || strncmp(point.board, geometry::NAME, sizeof(point.board)))
+        {
+            cout<<"Can't read "<<checkpointfile<<"."<<endl;
+            return 0;
+        }
+        opt.symmetry = (symmetry_mode)point.symmetry;
+        opt.branch = (branch_mode)point.branch;
+        opt.output = (output_format)point.output;
+    }
+
+    // the original set is built into the solver (no input file)
+    bool builtin = builtin_shapes(opt.name, geometry::DIMENSIONS, shapes);
+
+    // map compiled placements from cache file, if it is up to date
+    if (!opt.compile && puzzle.load(cachefile, builtin ? BUILTIN_SOURCE : inputfile, opt.symmetry))
+        cout<<to_string(puzzle.partcount)<<" Parts loaded from "<<cachefile<<"."<<endl;
+    else
+    {
+        // read parts from input file
+        if (builtin)
+            cout<<to_string(shapes.partcount)<<" Parts of built-in set "<<opt.name<<" loaded."<<endl;
+        else
+            cout<<to_string(read_input(inputfile, shapes, geometry::DIMENSIONS))<<" Parts loaded."<<endl;
+        if (shapes.partcount >= MAX_PARTS)
+        {
+            cout<<"Too many parts (at most "<<MAX_PARTS-1<<")."<<endl;
+            return 0;
+        }
+
+        // compile parts into occupancy masks for all positions on the board
+        puzzle.init(shapes, opt.symmetry);
+        if (opt.compile)
+        {
+            if (!puzzle.save(cachefile, opt.symmetry))
+            {
+                cout<<"Can't write "<<cachefile<<"."<<endl;
+                return 0;
+            }
+            cout<<to_string(puzzle.placements.size())<<" placements compiled into "<<cachefile<<"."<<endl;
+            return 0;
+        }
+    }
+    if (header && opt.index)
+        return build_index(puzzle, reader, *header, indexfile);
+    if (header && opt.lookup.size())
+        return lookup_challenges(puzzle, reader, *header, indexfile, opt);
+    if (header)
+        return convert_solutions(puzzle, reader, *header, opt.solution, outputfile);
+    if (opt.challenge.size())
+        return solve_challenges(puzzle, opt);
+    if (opt.serve.size())
+        return serve_queries(puzzle, opt);
+    if (opt.shards > 1 && puzzle.partcount < 3)
+    {
+        cout<<"Too few parts for shards (at least 3)."<<endl;
+        return 0;
+    }
+    puzzle.shard = opt.shard;
+    puzzle.shards = opt.shards;
+    puzzle.depth_limit = opt.depth && opt.depth < MAX_PARTS ? opt.depth : MAX_PARTS;
+    puzzle.nth = opt.stats;
+    if (opt.resume && !puzzle.resume(point))
+    {
+        cout<<"Checkpoint does not match the placements of the input file."<<endl;
+        return 0;
+    }
+    if (puzzle.symmetries.size())
+        cout<<"Symmetry group of order "<<to_string(puzzle.symmetries.size()+1)
+            <<(puzzle.symmetric_part ? string(", part ")+(char)(puzzle.symmetric_part+64)+" restricted." : string("."))<<endl;
+
+    if (!opt.quiet)
+    {
+        // get columns and lines of terminal
+        ioctl(0, TIOCGWINSZ, &w);
+        if (w.ws_row < geometry::SCREEN_ROWS)
+            w.ws_row = geometry::SCREEN_ROWS;
+        // scroll up screen by printing empty lines
+        for (uint16_t i = 0; i < geometry::SCREEN_ROWS; i++)
+            cout<<endl;
+
+        // terminal position of each field
+        vector <screen_position> layout(geometry::FIELDS);
+        for (uint8_t f = 0; f < geometry::FIELDS; f++)
+        {
+            layout[f] = geometry::screen(puzzle.board.layer[f], puzzle.board.row[f], puzzle.board.col[f]);
+            layout[f].row += w.ws_row - geometry::SCREEN_ROWS;
+        }
+        start_renderer(layout, vector <string>(geometry::COLOR, geometry::COLOR + 13), w.ws_row, opt.render_hz, &puzzle.solutions_found);
+    }
+
+    if (opt.metrics.size())
+        start_metrics(opt.metrics, shardname, puzzle.partcount, &puzzle.solutions_found);
+
+    if (opt.count)
+    {   // count solutions without solution file
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        uint64_t count = puzzle.count(opt.threads, opt.branch, opt.memory << 20);
+        stop_metrics();
+        stop_renderer();
+        if (!opt.quiet)
+            cout<<endl;
+        cout<<to_string(count)<<" solutions counted ("
+            <<chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count()/1000.0<<"s)."<<endl;
+        if (opt.stats)
+            show_statistics(puzzle, count, chrono::steady_clock::now() - start);
+        return count;
+    }
+
+    // open log file or binary solution file (resumed search: continue file at checkpoint)
+    puzzle.binary = opt.output == OUTPUT_BINARY;
+    if (puzzle.binary && opt.resume)
+        opened = puzzle.binaryfile.reopen(binaryfile, point.offset, point.solutions);
+    else if (puzzle.binary)
+    {
+        solution_header h = {};
+        strncpy(h.board, geometry::NAME, sizeof(h.board));
+        h.symmetry = opt.symmetry;
+        h.partcount = puzzle.partcount;
+        h.hash = puzzle.hash();
+        opened = puzzle.binaryfile.open(binaryfile, h);
+    }
+    else if (opt.resume)
+    {
+        opened = !truncate(outputfile.c_str(), point.offset);
+        puzzle.logfile.open(outputfile, ios::in | ios::out);
+        puzzle.logfile.seekp(point.offset);
+    }
+    else
+        puzzle.logfile.open(outputfile);
+    if (!opt.resume)
+        remove(checkpointfile.c_str());     // checkpoint of previous search is invalid
+    if (!opened || (!puzzle.binary && !puzzle.logfile))
+    {
+        cout<<"Can't write "<<(puzzle.binary ? binaryfile : outputfile)<<"."<<endl;
+        return 0;
+    }
+    puzzle.checkpointfile = checkpointfile;
+    puzzle.checkpoint_interval = opt.checkpoint;
+
+    // start backtracking (sequential or parallel)
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    puzzle.solve(opt.threads, opt.branch);
+    chrono::steady_clock::duration time = chrono::steady_clock::now() - start;
+
+    // close log file, search is complete
+    if (puzzle.binary)
+        puzzle.binaryfile.close();
+    else
+        puzzle.logfile.close();
+    remove(checkpointfile.c_str());
+
+    stop_metrics();
+    stop_renderer();
+    if (!opt.quiet)
+        cout<<endl;
+    cout<<to_string(puzzle.solutions)<<" solutions found."<<endl;
+    if (opt.stats)
+        show_statistics(puzzle, puzzle.solutions, time);
+
+    return puzzle.solutions;
+}
+
+#endif
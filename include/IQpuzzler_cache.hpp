@@ -0,0 +1,72 @@
+// Binary cache files with compiled placement tables (*.2dc, *.3dc), see IQpuzzler_bitboard.hpp.
+// A cache file starts with a header (magic, version, board and symmetry mode it was compiled for),
+// followed by the arrays of the tables as sections, each starting at a cache line boundary.
+// Cache files are mapped into memory with mmap, the solver uses the sections in place (no parsing, no copying).
+// They are only valid for the machine they were written on (byte order and type sizes are not converted).
+//
+// Last update: 10/17/2026
+
+#ifndef _IQPUZZLER_CACHE_
+#define _IQPUZZLER_CACHE_
+
+#include <cstdint>      // uint8_t, uint32_t, uint64_t
+#include <cstddef>      // size_t
+#include <string>       // string
+#include <fstream>      // ofstream
+
+using namespace std;
+
+#define CACHE_MAGIC "IQPZPLC"
+#define CACHE_VERSION 1
+#define CACHE_SECTION 64    // alignment of sections
+
+struct cache_header
+{
+    char magic[8];          // CACHE_MAGIC
+    uint32_t version;       // CACHE_VERSION
+    char board[8];          // name of board geometry
+    uint8_t symmetry;       // symmetry mode used for compilation
+    uint8_t partcount;
+    uint8_t symmetric_part;
+    uint8_t symmetry_count; // number of symmetries (without identity)
+    uint32_t placements;    // number of placements
+    uint32_t covering;      // entries of covering lists
+    uint32_t starting;      // entries of starting lists
+    uint32_t windows;       // size of window lookup tables
+    uint64_t size;          // size of file
+};
+
+// writes header and sections of a cache file
+class cache_writer
+{
+public:
+    bool open(const string & filename);
+    void section(const void * data, size_t bytes);  // appends data, padded to CACHE_SECTION
+    bool close(cache_header & header);              // writes header (with final size) and closes file
+
+private:
+    ofstream file;
+    uint64_t size = 0;
+};
+
+// read-only memory mapping of a cache file, sections are taken one after the other
+class cache_reader
+{
+public:
+    ~cache_reader();
+    // maps file if it exists and is newer than source file, returns header or nullptr
+    const cache_header * open(const string & filename, const string & source);
+    template <typename T> const T * section(size_t count)
+    {
+        const T * data = (const T *)(base + offset);
+        offset += (count*sizeof(T) + CACHE_SECTION-1) / CACHE_SECTION * CACHE_SECTION;
+        return offset <= length ? data : nullptr;
+    }
+
+private:
+    const uint8_t * base = nullptr;
+    size_t length = 0;
+    size_t offset = 0;
+};
+
+#endif
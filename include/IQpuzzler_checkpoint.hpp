@@ -0,0 +1,52 @@
+// Checkpoint files of a running search (*.ckp), see IQpuzzler_bitboard.hpp.
+// A checkpoint describes a node of the search tree by the placements on its path (part, orientation and position
+// of each level), together with the number of solutions and the size of the solution file at the time the node
+// was entered: all solutions before this node (in search order) are in the solution file, none of its subtree.
+// The file is replaced atomically (written to a temporary file, then renamed), so it is always complete.
+//
+// Last update: 10/17/2026
+
+#ifndef _IQPUZZLER_CHECKPOINT_
+#define _IQPUZZLER_CHECKPOINT_
+
+#include <cstdint>      // uint8_t, uint32_t, uint64_t
+#include <string>       // string
+
+using namespace std;
+
+#define CHECKPOINT_MAGIC "IQPZCKP"
+#define CHECKPOINT_VERSION 1
+#define CHECKPOINT_LEVELS 16
+
+// placement of one level of the search path
+struct checkpoint_level
+{
+    uint8_t part;
+    uint8_t orientation;
+    uint8_t layer;
+    uint8_t row;
+    uint8_t col;
+};
+
+struct checkpoint
+{
+    char magic[8];          // CHECKPOINT_MAGIC
+    uint32_t version;       // CHECKPOINT_VERSION
+    char board[8];          // name of board geometry
+    uint8_t symmetry;       // symmetry mode of the search
+    uint8_t branch;         // branching of the search
+    uint8_t output;         // format of the solution file
+    uint8_t depth;          // number of levels of the path
+    uint64_t hash;          // hash of the placement table
+    uint64_t solutions;     // solutions in solution file
+    uint64_t offset;        // size of solution file
+    uint32_t seconds;       // run time of the search
+    checkpoint_level level[CHECKPOINT_LEVELS];
+};
+
+// writes checkpoint (replaces existing file), returns false if the file can't be written
+bool write_checkpoint(const string & filename, checkpoint & point);
+// reads checkpoint, returns false if the file is missing or invalid
+bool read_checkpoint(const string & filename, checkpoint & point);
+
+#endif
@@ -0,0 +1,55 @@
+// Inner kernels of the bitboard search with runtime CPU dispatch (--cpu).
+// The kernels are compiled in several variants for x86-64, the best variant supported by the CPU is selected at startup:
+// baseline = x86-64 without extensions (software bit extract, popcount of the compiler runtime)
+// bmi2     = popcnt, tzcnt and pext (window index of the dead space lookup with a single instruction)
+// avx2     = bmi2 kernels, fit test of four placements at once with 256 bit vectors
+// Kernels:
+// - extract: window index of the dead space lookup table (parallel bit extract)
+// - first_field: first empty field along the scan lines (first field branching)
+// - fill_region: bounded flood fill of a free region (pocket and region size checks)
+// - cavity: free fields without free neighbour space on any plane (pyramid)
+// - fits: fit test of a block of placements (field based branching, challenge and daemon search)
+// The search calls the kernels through the function pointers in kernels, which are set once before the search starts.
+// On other architectures (including 32 bit x86), only the baseline variant exists.
+//
+// Last update: 10/17/2026
+
+#ifndef _IQPUZZLER_CPU_
+#define _IQPUZZLER_CPU_
+
+#include <cstdint>      // uint8_t, uint16_t, uint64_t
+#include <cstddef>      // size_t
+
+using namespace std;
+
+enum cpu_variant {CPU_AUTO, CPU_BASELINE, CPU_BMI2, CPU_AVX2};
+
+#define KERNEL_BLOCK 64     // placements of one fit test
+
+struct search_kernels
+{
+    cpu_variant variant;
+    const char * name;
+    // gathers the bits of x at the positions of mask into the lowest bits
+    uint64_t (*extract)(uint64_t x, uint64_t mask);
+    // returns the lowest field of mask in the first scan line which contains a field of mask (0 if none)
+    uint8_t (*first_field)(const uint64_t lines[], size_t count, uint64_t mask);
+    // grows region with the free neighbour fields until it is closed or has at least limit fields,
+    // returns the number of fields of region, open is set if region could grow further
+    unsigned (*fill_region)(const uint64_t neighbours[], uint64_t & region, uint64_t free, unsigned limit, bool & open);
+    // checks if a field of check is free, but has neither two free neighbours on one plane nor free space
+    // beyond its only free neighbour (tables of the board map, planes per field and 4 directions per plane)
+    bool (*cavity)(const uint64_t plane_neighbours[], const uint64_t next_field[], const uint64_t further[],
+                   unsigned planes, uint64_t free, uint64_t check);
+    // fit test of count <= KERNEL_BLOCK placements: bit i is set if part[i] is remaining and mask[i] doesn't overlap occupied
+    uint64_t (*fits)(const uint64_t mask[], const uint8_t part[], size_t count, uint64_t occupied, uint16_t remaining);
+};
+
+extern search_kernels kernels;      // kernels used by the search (baseline until select_kernels is called)
+
+// returns the best variant supported by the CPU
+cpu_variant detect_cpu();
+// selects the kernels of variant (CPU_AUTO = best supported), returns false if the CPU doesn't support variant
+bool select_kernels(cpu_variant variant);
+
+#endif
@@ -0,0 +1,149 @@
+// Board geometries of the IQpuzzler games, used as policies for the search engine (see IQpuzzler_bitboard.hpp).
+// The fields of each board are positions (layer, row, col) inside a bounding box of LAYERS x ROWS x COLS,
+// numbered layer by layer, row by row (bit 0 is the first field of the top row of the first layer).
+// All members are compile-time constants, so the engine can compute its cell maps at compile time.
+//
+// Each geometry defines:
+// - file names: NAME (suffix of log, solution and cache file), INPUT, OUTPUT, BINARY, CACHE and INDEX
+//   (extensions of input, log, binary solution, cache and solution index file)
+// - DIMENSIONS: coordinates of each dot in the input file ({x,y} or {x,y,z})
+// - FIELDS and bounding box, field(layer,row,col) = position belongs to the board
+// - anchor(layer,row,col) = position where the origin of a part orientation is placed in the search (in search order)
+// - DIRECTIONS: steps {layer,row,col} to the neighbour fields, four per plane in which a part can lie
+//   (in circular order, so the opposite direction of direction d is (d+2)%4 within the same plane)
+// - WINDOW: use lookup tables for the free region within distance 2 of a field (2D boards only)
+// - output layout: MARGIN (character for positions outside of the board in the log file, 0 = omit),
+//   SCREEN_ROWS and screen(layer,row,col) for the terminal visualization, COLOR for each part
+//
+// Last update: 10/17/2026
+
+#ifndef _IQPUZZLER_GEOMETRY_
+#define _IQPUZZLER_GEOMETRY_
+
+#include <cstdint>      // uint8_t, int8_t, uint16_t
+#include "IQpuzzler_render.hpp"     // screen_position
+
+// 2D 5x11 rectangular board
+struct rect_geometry
+{
+    static constexpr const char* NAME = "rect";
+    static constexpr const char* INPUT = ".2di";
+    static constexpr const char* OUTPUT = ".2do";
+    static constexpr const char* BINARY = ".2db";
+    static constexpr const char* CACHE = ".2dc";
+    static constexpr const char* INDEX = ".2dx";
+    static constexpr uint8_t DIMENSIONS = 2;
+    static constexpr uint8_t FIELDS = 55;
+    static constexpr int LAYERS = 1, ROWS = 5, COLS = 11;
+    static constexpr uint8_t PLANES = 1;
+    static constexpr int8_t DIRECTIONS[4*PLANES][3] = {{0,-1,0},{0,0,1},{0,1,0},{0,0,-1}};
+    static constexpr bool WINDOW = true;
+    static constexpr char MARGIN = ' ';
+    static constexpr uint16_t SCREEN_ROWS = 6;
+    // ANSI escape color codes (4-bit)
+    static constexpr const char* COLOR[13] =
+    {   "\033[1;0m",   // black
+        "\033[1;46m",  // mid blue
+        "\033[1;101m", // red
+        "\033[1;43m",  // orange
+        "\033[1;42m",  // dark green
+        "\033[1;45m",  // magenta
+        "\033[1;102m", // light green
+        "\033[1;103m", // yellow
+        "\033[1;105m", // pink
+        "\033[1;106m", // cyan
+        "\033[1;100m", // gray (no dark red in 4-bit color scheme)
+        "\033[1;44m",  // dark blue
+        "\033[1;104m"  // light blue
+    };
+
+    static constexpr bool field(int layer, int row, int col) { return true; }
+    static constexpr bool anchor(int layer, int row, int col) { return true; }
+    // square (two blanks with background color) at row-col-location
+    static constexpr screen_position screen(int layer, int row, int col) { return {(uint16_t)(row+1), (uint16_t)(2*col+1)}; }
+};
+
+// 2D diagonal arrangement: board 9x9 with some reserved areas, rotated by 45°
+struct diag_geometry
+{
+    static constexpr const char* NAME = "diag";
+    static constexpr const char* INPUT = ".2di";
+    static constexpr const char* OUTPUT = ".2do";
+    static constexpr const char* BINARY = ".2db";
+    static constexpr const char* CACHE = ".2dc";
+    static constexpr const char* INDEX = ".2dx";
+    static constexpr uint8_t DIMENSIONS = 2;
+    static constexpr uint8_t FIELDS = 55;
+    static constexpr int LAYERS = 1, ROWS = 9, COLS = 9;
+    static constexpr uint8_t PLANES = 1;
+    static constexpr int8_t DIRECTIONS[4*PLANES][3] = {{0,-1,0},{0,0,1},{0,1,0},{0,0,-1}};
+    static constexpr bool WINDOW = true;
+    static constexpr char MARGIN = ' ';
+    static constexpr uint16_t SCREEN_ROWS = 10;
+    static constexpr const char* SHAPE[ROWS] =
+    {   " XXXX    ",
+        "XXXXX    ",
+        "XXXXXXX  ",
+        "XXXXXXX  ",
+        "XXXXXXXXX",
+        "  XXXXXXX",
+        "  XXXXXXX",
+        "    XXXXX",
+        "    XXXX "
+    };
+    static constexpr const char* const (&COLOR)[13] = rect_geometry::COLOR;
+
+    static constexpr bool field(int layer, int row, int col) { return SHAPE[row][col] == 'X'; }
+    static constexpr bool anchor(int layer, int row, int col) { return true; }
+    static constexpr screen_position screen(int layer, int row, int col) { return {(uint16_t)(row+1), (uint16_t)(2*col+1)}; }
+};
+
+// 3D pyramid with 5 layers (5x5, 4x4, 3x3, 2x2, 1x1 fields)
+// Horizontal positions use double steps, layers are shifted by 1 step, so the fields of layer z are at
+// rows and columns z, z+2, ..., 8-z. Parts can lie horizontally or in the two vertical planes parallel to x=y and x=-y.
+struct pyramid_geometry
+{
+    static constexpr const char* NAME = "pyra";
+    static constexpr const char* INPUT = ".3di";
+    static constexpr const char* OUTPUT = ".3do";
+    static constexpr const char* BINARY = ".3db";
+    static constexpr const char* CACHE = ".3dc";
+    static constexpr const char* INDEX = ".3dx";
+    static constexpr uint8_t DIMENSIONS = 3;
+    static constexpr uint8_t FIELDS = 55;
+    static constexpr int LAYERS = 5, ROWS = 9, COLS = 9;
+    static constexpr uint8_t PLANES = 3;
+    static constexpr int8_t DIRECTIONS[4*PLANES][3] =
+    {   { 1, 1, 1},{-1, 1, 1},{-1,-1,-1},{ 1,-1,-1},    // 4 directions in plane parallel to x=y
+        { 0, 2, 0},{ 0, 0,-2},{ 0,-2, 0},{ 0, 0, 2},    // 4 directions in plane parallel to z=0
+        { 1,-1, 1},{-1,-1, 1},{-1, 1,-1},{ 1, 1,-1}     // 4 directions in plane parallel to x=-y
+    };
+    static constexpr bool WINDOW = false;
+    static constexpr char MARGIN = 0;
+    static constexpr uint16_t SCREEN_ROWS = 6;
+    static constexpr const char* COLOR[13] =
+    {   "\033[1;0m",   // black
+        "\033[1;101m", // red
+        "\033[1;43m",  // orange
+        "\033[1;42m",  // dark green
+        "\033[1;102m", // light green
+        "\033[1;103m", // yellow
+        "\033[1;105m", // pink
+        "\033[1;46m",  // mid blue
+        "\033[1;45m",  // magenta
+        "\033[1;44m",  // dark blue
+        "\033[1;106m", // cyan
+        "\033[1;100m", // gray (no dark red in 4bit color scheme)
+        "\033[1;104m"  // light blue
+    };
+
+    static constexpr bool field(int layer, int row, int col)
+    {
+        return row >= layer && row <= 8-layer && col >= layer && col <= 8-layer && (row-layer) % 2 == 0 && (col-layer) % 2 == 0;
+    }
+    static constexpr bool anchor(int layer, int row, int col) { return field(layer, row, col); }
+    // layers side by side
+    static constexpr screen_position screen(int layer, int row, int col) { return {(uint16_t)(row/2+1), (uint16_t)(12*layer+col+1)}; }
+};
+
+#endif
@@ -0,0 +1,92 @@
+// Indexed solution database (*.2dx, *.3dx), built from a binary solution file (--index), see IQpuzzler_bitboard.hpp.
+// The index holds a set of solutions (numbers of the solutions in the binary solution file, from 0) for each placement
+// of the placement table, and one for each field and part (solutions in which the part covers the field).
+// Each set is a bitset over the solution numbers in 64 bit words: dense sets store all words, sparse sets
+// (most placement sets) only their nonzero words, with the position of each word.
+// The solutions consistent with a challenge are the intersection of the sets of its placements and fields:
+// the words of the smallest set are ANDed with the words at the same positions of the other sets
+// (direct access in dense sets, forward search in sparse sets), no search of the puzzle is needed.
+// Index files are mapped into memory with mmap and used in place, like cache files they are only valid
+// for the machine they were written on.
+//
+// Last update: 10/17/2026
+
+#ifndef _IQPUZZLER_INDEX_
+#define _IQPUZZLER_INDEX_
+
+#include <cstdint>      // uint8_t, uint32_t, uint64_t
+#include <cstddef>      // size_t
+#include <string>       // string
+#include <vector>       // vector
+
+using namespace std;
+
+#define INDEX_MAGIC "IQPZIDX"
+#define INDEX_VERSION 1
+#define INDEX_MAX_SETS 128      // maximum number of sets of a query
+
+struct index_header
+{
+    char magic[8];          // INDEX_MAGIC
+    uint32_t version;       // INDEX_VERSION
+    char board[8];          // name of board geometry
+    uint8_t symmetry;       // symmetry mode of the placement table (as solution file)
+    uint8_t partcount;
+    uint8_t fields;
+    uint8_t reserved;
+    uint64_t hash;          // hash of the placement table
+    uint64_t solutions;     // number of solutions
+    uint32_t placements;    // sets 0 .. placements-1: placements
+    uint32_t sets;          // sets from placements on: field * partcount + part-1
+    uint64_t words;         // 64 bit words of all sets
+    uint64_t positions;     // word positions of all sparse sets
+    uint64_t size;          // size of file
+};
+
+struct index_set
+{
+    uint64_t word;          // first word of the set
+    uint64_t position;      // position of its first word (sparse set)
+    uint64_t solutions;     // number of solutions in the set
+    uint32_t words;         // number of words
+    uint32_t dense;         // 1 = all words of the bitset, 0 = nonzero words with positions
+};
+
+// collects the sets in memory, solutions have to be added in increasing order
+class index_writer
+{
+public:
+    void init(uint32_t sets);
+    void add(uint32_t set, uint64_t solution);
+    bool write(const string & filename, index_header & header);    // completes header (counts, size)
+
+private:
+    vector <vector <uint32_t> > positions;
+    vector <vector <uint64_t> > words;
+};
+
+// read-only memory mapping of an index file
+class index_reader
+{
+public:
+    ~index_reader();
+    // maps file, returns header or nullptr if file is missing or invalid
+    const index_header * open(const string & filename);
+    // returns number of solutions in the intersection of the sets (all solutions if there are none),
+    // adds the first solutions of the intersection to found, until found holds limit solutions (0 = no limit)
+    uint64_t intersect(const uint32_t sets[], size_t count, uint64_t limit, vector <uint64_t> & found) const;
+    // checks if the intersection of the sets contains any solution
+    bool any(const uint32_t sets[], size_t count) const;
+
+private:
+    const uint8_t * base = nullptr;
+    size_t length = 0;
+    const index_header * header = nullptr;
+    const index_set * set = nullptr;
+    const uint64_t * words = nullptr;
+    const uint32_t * positions = nullptr;
+
+    uint64_t scan(const uint32_t sets[], size_t count, uint64_t limit, vector <uint64_t> * found, bool first) const;
+};
+
+#endif
@@ -0,0 +1,321 @@
+// Exact cover solver for all IQpuzzler boards: Knuth's algorithm X with Dancing Links (DLX), templated on the
+// board geometry like the bitboard engine (see IQpuzzler_geometry.hpp). The front ends only instantiate it.
+// The rows of the exact cover matrix are the placements of the bitboard engine (symmetry off): every orientation
+// at every position where it fits into the cell map of the board (rectangle, diagonal layout or pyramid layers),
+// so the matrix is built from the board shape alone and the solutions are logged in the layout of the bitboard solvers.
+// The columns are the fields of the board, followed by the parts (each part has to be used once).
+//
+// Tuning for the search (which always covers the column with the fewest rows):
+// - Rows which can't be part of any solution are removed before the search: a placement is dropped if it leaves a field
+//   or a part which no other placement without overlap can cover any more. Dropping rows can make further rows
+//   impossible, so this is repeated until nothing changes. Small enclosed pockets at the border are found this way.
+// - The column with the fewest rows is searched until a column without rows is found (dead end, no branching),
+//   not only until a column with one row.
+// - Fields are ordered line by line along the shorter side of the board (as the first-field branching of the bitboard
+//   engine and the original rectangle solver), before the parts, so ties of the column choice go to the field
+//   next to the filled area (the order changes the number of nodes by less than 1%).
+//
+// Last update: 10/17/2026
+
+#ifndef _IQPUZZLER_KNUTH_
+#define _IQPUZZLER_KNUTH_
+
+#include "IQpuzzler_bitboard.hpp"       // placement table and output layout of the bitboard engine
+
+// Dancing links: node 0 is the root, nodes 1..columns are the column headers, followed by one node per entry of the matrix.
+// Each node is linked to its neighbours in the same row (left, right) and in the same column (up, down).
+struct dlx_node
+{
+    uint32_t left, right, up, down;
+    uint32_t column;    // column header
+    uint32_t row;       // row of the matrix (index of placement)
+};
+
+template <typename geometry>
+class knuth_solver
+{
+public:
+    bitboard_solver <geometry> puzzle;      // placement table (rows of the matrix) and output of solutions
+    ofstream logfile;                       // output: log file with solutions and time stamps
+    size_t rows = 0;                        // rows of the matrix after removal of impossible placements
+    size_t depth_limit = SIZE_MAX;          // parts on board at which the search stops (--depth)
+    uint64_t solutions = 0;
+    uint64_t nodes = 0, tested = 0;         // nodes of the search tree (rows with a non-empty next column or solutions), rows tried
+    uint64_t nth = 0;                       // number of solution whose time is measured
+    int64_t first_time = -1, nth_time = -1; // time to first and nth solution in ns (-1 = none)
+
+    void prepare(const shape_table & shapes);
+    void solve();
+
+private:
+    vector <dlx_node> links;
+    vector <uint32_t> column_size;          // number of entries in each column (maintained while covering/uncovering)
+    placement_index solution[MAX_PARTS];    // rows of the partial solution
+    size_t depth = 0;
+    chrono::steady_clock::time_point start;
+
+    vector <bool> possible_rows();
+    void cover(uint32_t c);
+    void uncover(uint32_t c);
+    void search();
+};
+
+// removes placements which leave a field or a part that can't be covered any more, returns the remaining rows
+template <typename geometry>
+vector <bool> knuth_solver<geometry>::possible_rows()
+{
+    const placement_view & placements = puzzle.placements;
+    vector <bool> possible(placements.size(), true);
+    bool changed = true;
+
+    while (changed)
+    {
+        changed = false;
+        for (size_t p = 0; p < placements.size(); p++)
+        {
+            if (!possible[p])
+                continue;
+            bitboard mask = placements.mask[p];
+            uint32_t covered = 0;   // parts which still have a placement next to p (bit n for part n)
+            bitboard reachable = mask;
+            for (size_t q = 0; q < placements.size(); q++)
+                if (possible[q] && placements.part[q] != placements.part[p] && !(placements.mask[q] & mask))
+                {
+                    covered |= 1 << placements.part[q];
+                    reachable |= placements.mask[q];
+                }
+            covered |= 1 << placements.part[p];
+            if (reachable != puzzle.board.all || covered != ((2u << puzzle.partcount) - 2))
+            {
+                possible[p] = false;
+                changed = true;
+            }
+        }
+    }
+    return possible;
+}
+
+// builds the toroidal doubly-linked list of the exact cover matrix
+template <typename geometry>
+void knuth_solver<geometry>::prepare(const shape_table & shapes)
+{
+    const placement_view & placements = puzzle.placements;
+    uint32_t column_of_field[MAX_FIELDS], columns = geometry::FIELDS + shapes.partcount, entries = 0, c = 1, n, first;
+
+    puzzle.init(shapes, SYMMETRY_OFF);
+    vector <bool> possible = possible_rows();
+
+    // fields line by line along the shorter side of the board, then parts
+    for (int z = 0; z < geometry::LAYERS; z++)
+        for (int line = 0; line < max(geometry::ROWS, geometry::COLS); line++)
+            for (int i = 0; i < min(geometry::ROWS, geometry::COLS); i++)
+            {
+                int y = geometry::COLS > geometry::ROWS ? i : line, x = geometry::COLS > geometry::ROWS ? line : i;
+                if (puzzle.board.field[z][y][x] >= 0)
+                    column_of_field[puzzle.board.field[z][y][x]] = c++;
+            }
+
+    rows = 0;
+    for (size_t p = 0; p < placements.size(); p++)
+        if (possible[p])
+        {
+            rows++;
+            entries += __builtin_popcountll(placements.mask[p]) + 1;
+        }
+    links.resize(1 + columns + entries);
+    column_size.assign(1 + columns, 0);
+
+    // root and column headers form a circular list
+    for (c = 0; c <= columns; c++)
+    {
+        links[c].left = c ? c-1 : columns;
+        links[c].right = c < columns ? c+1 : 0;
+        links[c].up = links[c].down = links[c].column = c;
+    }
+
+    // append one node for each entry, rows are circular lists as well
+    n = columns + 1;
+    for (size_t p = 0; p < placements.size(); p++)
+    {
+        if (!possible[p])
+            continue;
+        first = n;
+        uint32_t row_columns[MAX_FIELDS+1], count = 0;
+        for (bitboard mask = placements.mask[p]; mask; mask &= mask-1)
+            row_columns[count++] = column_of_field[__builtin_ctzll(mask)];
+        row_columns[count++] = geometry::FIELDS + placements.part[p];
+        for (uint32_t e = 0; e < count; e++)
+        {
+            c = row_columns[e];
+            links[n].column = c;
+            links[n].row = p;
+            links[n].up = links[c].up;
+            links[n].down = c;
+            links[links[c].up].down = n;
+            links[c].up = n;
+            links[n].left = n-1;
+            links[n].right = n+1;
+            column_size[c]++;
+            n++;
+        }
+        links[first].left = n-1;
+        links[n-1].right = first;
+    }
+}
+
+// remove column c from header list and all rows with an entry in column c from the other columns
+template <typename geometry>
+void knuth_solver<geometry>::cover(uint32_t c)
+{
+    links[links[c].right].left = links[c].left;
+    links[links[c].left].right = links[c].right;
+    for (uint32_t i = links[c].down; i != c; i = links[i].down)
+        for (uint32_t j = links[i].right; j != i; j = links[j].right)
+        {
+            links[links[j].down].up = links[j].up;
+            links[links[j].up].down = links[j].down;
+            column_size[links[j].column]--;
+        }
+}
+
+// undo cover(c) in exactly reverse order
+template <typename geometry>
+void knuth_solver<geometry>::uncover(uint32_t c)
+{
+    for (uint32_t i = links[c].up; i != c; i = links[i].up)
+        for (uint32_t j = links[i].left; j != i; j = links[j].left)
+        {
+            column_size[links[j].column]++;
+            links[links[j].down].up = j;
+            links[links[j].up].down = j;
+        }
+    links[links[c].right].left = c;
+    links[links[c].left].right = c;
+}
+
+// Knuth's algorithm X with Dancing Links, as published in https://www.ocf.berkeley.edu/~jchu/publicportal/sudoku/0011047.pdf
+// Covered columns and rows are unlinked from the list and relinked on backtracking.
+template <typename geometry>
+void knuth_solver<geometry>::search()
+{
+    // if no column is left, a solution is found
+    if (links[0].right == 0)
+    {
+        int64_t time = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+        solutions++;
+        nodes++;
+        if (solutions == 1)
+            first_time = time;
+        if (solutions == nth)
+            nth_time = time;
+        puzzle.write_solution(logfile, solution, solutions, time / 1000000000);
+        return;
+    }
+    if (depth >= depth_limit)   // bounded search
+    {
+        nodes++;
+        return;
+    }
+
+    // choose column with minimum number of entries (this will minimize the number of recursions)
+    uint32_t min_column = links[0].right;
+    for (uint32_t c = links[min_column].right; c != 0 && column_size[min_column]; c = links[c].right)
+        if (column_size[c] < column_size[min_column])
+            min_column = c;
+    if (!column_size[min_column])
+        return;
+    if (depth)
+        nodes++;
+
+    cover(min_column);
+    // for each row with an entry in min_column
+    for (uint32_t r = links[min_column].down; r != min_column; r = links[r].down)
+    {
+        // include row in partial solution
+        tested++;
+        solution[depth++] = links[r].row;
+        // for each other column of this row: delete column
+        for (uint32_t j = links[r].right; j != r; j = links[j].right)
+            cover(links[j].column);
+        // repeat algorithm recursively on the reduced matrix
+        search();
+        for (uint32_t j = links[r].left; j != r; j = links[j].left)
+            uncover(links[j].column);
+        depth--;
+    }
+    uncover(min_column);
+}
+
+template <typename geometry>
+void knuth_solver<geometry>::solve()
+{
+    start = chrono::steady_clock::now();
+    search();
+}
+
+// front end of the exact cover solvers: reads parts, searches all solutions and logs them
+template <typename geometry>
+int run_knuth(int argc, char *argv[])
+{
+    knuth_solver <geometry> knuth;
+    shape_table shapes;     // part shapes incl. all possible orientations
+    string name = "orig", inputfile, outputfile;
+    bool stats = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if ((arg == "--depth" || arg == "--stats") && i+1 < argc && atoi(argv[i+1]) > 0)
+        {
+            if (arg == "--depth")
+                knuth.depth_limit = atoi(argv[++i]);
+            else
+            {
+                knuth.nth = atoi(argv[++i]);
+                stats = true;
+            }
+        }
+        else if (arg.size() && arg[0] != '-')
+            name = arg;
+        else
+        {
+            cerr << "Usage: " << argv[0] << " [filename] [--depth D] [--stats N]" << endl;
+            return 0;
+        }
+    }
+    inputfile = name + geometry::INPUT;
+    outputfile = name + "_" + geometry::NAME + geometry::OUTPUT;
+
+    if (builtin_shapes(name, geometry::DIMENSIONS, shapes))
+        cout << to_string(shapes.partcount) << " Parts of built-in set " << name << " loaded." << endl;
+    else
+        cout << to_string(read_input(inputfile, shapes, geometry::DIMENSIONS)) << " Parts loaded." << endl;
+    if (shapes.partcount >= MAX_PARTS)
+    {
+        cout << "Too many parts (at most " << MAX_PARTS-1 << ")." << endl;
+        return 0;
+    }
+    knuth.prepare(shapes);
+    cout << knuth.rows << " of " << knuth.puzzle.placements.size() << " placements possible." << endl;
+
+    knuth.logfile.open(outputfile);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    knuth.solve();
+    knuth.logfile.close();
+
+    cout << to_string(knuth.solutions) << " solutions found." << endl;
+    if (stats)
+    {   // same format as the bitboard solvers (read by bench/bench.sh)
+        double ms = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count() / 1000.0;
+        double seconds = ms > 0 ? ms / 1000 : 1;
+        cout << fixed << setprecision(3) << "stats nodes=" << knuth.nodes << " tested=" << knuth.tested
+             << " solutions=" << knuth.solutions
+             << " nodes_per_s=" << (uint64_t)(knuth.nodes / seconds) << " tested_per_s=" << (uint64_t)(knuth.tested / seconds)
+             << " first_ms=" << (knuth.first_time < 0 ? -1 : knuth.first_time / 1e6)
+             << " nth=" << knuth.nth << " nth_ms=" << (knuth.nth_time < 0 ? -1 : knuth.nth_time / 1e6)
+             << " total_ms=" << ms << endl;
+    }
+    return(knuth.solutions);
+}
+
+#endif
@@ -0,0 +1,79 @@
+// Transposition table for counting solutions (--count), see IQpuzzler_bitboard.hpp.
+// Stores the number of completions of a search state (occupied fields, remaining parts),
+// so states which are reached by different sequences of placements are only searched once.
+// The table has a fixed size (memory budget): entries are grouped into buckets of one cache line,
+// if a bucket is full, the entry with the fewest remaining parts (cheapest to search again) is replaced.
+//
+// Last update: 10/17/2026
+
+#ifndef _IQPUZZLER_MEMO_
+#define _IQPUZZLER_MEMO_
+
+#include "IQpuzzler_shapes.hpp"     // aligned_vector
+#include <cstdint>      // uint16_t, uint64_t
+#include <cstddef>      // size_t
+
+#define MEMO_WAYS 4     // entries per bucket (one cache line)
+
+struct memo_entry
+{
+    uint64_t occupied;
+    uint64_t data;      // remaining parts (bits 0..15, 0 = empty entry) and number of completions (bits 16..63)
+};
+
+class memo_table
+{
+public:
+    // allocates buckets for the given number of bytes (rounded down to a power of 2)
+    void init(size_t bytes)
+    {
+        size_t buckets = 1;
+        while (2*buckets*MEMO_WAYS*sizeof(memo_entry) <= bytes)
+            buckets *= 2;
+        entries.assign(buckets*MEMO_WAYS, memo_entry());
+        mask = buckets-1;
+    }
+    size_t size() const { return entries.size(); }
+
+    bool find(uint64_t occupied, uint16_t remaining, uint64_t & count) const
+    {
+        const memo_entry * bucket = &entries[index(occupied, remaining)];
+        for (int way = 0; way < MEMO_WAYS; way++)
+            if (bucket[way].occupied == occupied && (uint16_t)bucket[way].data == remaining)
+            {
+                count = bucket[way].data >> 16;
+                return true;
+            }
+        return false;
+    }
+
+    void store(uint64_t occupied, uint16_t remaining, uint64_t count)
+    {
+        memo_entry * bucket = &entries[index(occupied, remaining)];
+        int victim = 0;
+        for (int way = 0; way < MEMO_WAYS; way++)
+        {
+            if (!(uint16_t)bucket[way].data)
+            {   // empty entry
+                victim = way;
+                break;
+            }
+            if (__builtin_popcount((uint16_t)bucket[way].data) < __builtin_popcount((uint16_t)bucket[victim].data))
+                victim = way;
+        }
+        bucket[victim].occupied = occupied;
+        bucket[victim].data = count << 16 | remaining;
+    }
+
+private:
+    aligned_vector <memo_entry> entries;
+    size_t mask = 0;    // number of buckets - 1
+
+    size_t index(uint64_t occupied, uint16_t remaining) const
+    {
+        uint64_t h = (occupied ^ (uint64_t)remaining << 55) * 0x9e3779b97f4a7c15ull;
+        return (h >> 32 & mask) * MEMO_WAYS;
+    }
+};
+
+#endif
@@ -0,0 +1,57 @@
+// Search instrumentation (--metrics FILE), compiled in with SEARCH_METRICS (make SEARCH_METRICS=1), see IQpuzzler_bitboard.hpp.
+// For each search depth (parts on board) and each part to be placed, the search counts the placements tried,
+// the placements rejected by overlap and by each dead space check, and the nodes (placements which passed all checks).
+// Each search thread counts into its own block of counters (allocated at its first count), so counting is
+// a plain increment without contention. A publisher thread sums all blocks periodically and replaces FILE with
+// a JSON snapshot (written to a temporary file, then renamed, so a polling tool always reads a complete file),
+// the final snapshot is written when the search is complete.
+// Without SEARCH_METRICS, METRIC() expands to an empty expression and the search is not slowed down.
+//
+// Last update: 10/17/2026
+
+#ifndef _IQPUZZLER_METRICS_
+#define _IQPUZZLER_METRICS_
+
+#include <cstdint>      // uint8_t, uint64_t
+#include <string>       // string
+#include <atomic>       // atomic
+
+using namespace std;
+
+#define METRIC_DEPTHS 16        // search depths (parts on board)
+#define METRIC_PARTS 16         // part numbers
+#define METRIC_INTERVAL_MS 1000 // time between snapshots
+
+enum metric {METRIC_TRIED, METRIC_OVERLAP, METRIC_CAVITY, METRIC_POCKET_SMALL, METRIC_POCKET_FIT, METRIC_REGION,
+             METRIC_NODES, METRICS};
+
+struct metric_block
+{
+    atomic <uint64_t> count[METRIC_DEPTHS][METRIC_PARTS][METRICS];
+};
+
+extern thread_local metric_block * metric_local;   // counters of the calling thread (nullptr before its first count)
+
+// allocates and registers counters of the calling thread
+metric_block * metric_register();
+
+// counts event m for placing part at depth (only the calling thread writes its counters, so no atomic increment is needed)
+inline void metric_add(uint8_t depth, uint8_t part, metric m)
+{
+    metric_block * block = metric_local ? metric_local : metric_register();
+    atomic <uint64_t> & counter = block->count[depth][part][m];
+    counter.store(counter.load(memory_order_relaxed) + 1, memory_order_relaxed);
+}
+
+#ifdef SEARCH_METRICS
+#define METRIC(depth, part, m) metric_add(depth, part, m)
+#else
+#define METRIC(depth, part, m) ((void)0)
+#endif
+
+// starts publisher thread for snapshots of the counters of a board with the given number of parts
+void start_metrics(const string & filename, const string & board, uint8_t partcount, const atomic <uint64_t> * solutions);
+// writes final snapshot and stops publisher thread (no effect if it was not started)
+void stop_metrics();
+
+#endif
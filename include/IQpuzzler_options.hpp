@@ -0,0 +1,99 @@
+// Command line options for the IQpuzzler solvers.
+// Usage: <solver> [filename] [options]
+// filename: input file without extension (default: orig), several files (piece sets) only with --serve
+// Options:
+//   --threads N    parallel search with N threads (default: 1 = sequential search)
+//   --render-hz F  refresh rate of the terminal visualization (default: 10)
+//   --quiet        no visualization of the search
+//   --branch M     branching of the search (default: part):
+//                  part   = place parts in order of input file, each part at all positions
+//                  first  = cover first empty field, with all remaining parts which fit there
+//                  fewest = cover empty field with fewest fitting placements of remaining parts
+//   --symmetry M   handling of symmetric solutions (default: break):
+//                  break  = search only one placement of a part for each set of symmetric placements
+//                  dedup  = full search, log only the smallest solution of each set of symmetric solutions
+//                  off    = log all solutions
+//   --compile      write placement table to binary cache file (filename_board.2dc / .3dc) and exit,
+//                  later runs with the same symmetry mode map the cache file instead of reading the input file
+//   --output F     format of the solution file (default: text):
+//                  text   = solutions as text grids (filename_board.2do / .3do)
+//                  binary = solutions as placement indices with block index (filename_board.2db / .3db)
+//   --convert      convert binary solution file to text solution file and exit
+//   --index        build the solution index of the binary solution file (filename_board.2dx / .3dx) and exit,
+//                  the solution file has to be written with --symmetry dedup or off (or break, if no part is restricted)
+//   --lookup F     answer the challenges of file F from the solution index (format as for --challenge,
+//                  grid lines may also contain hints: a,b,c,... = field covered by part A,B,C,...),
+//                  results are written to F_board.2do / .3do (without extension of F)
+//   --exists       with --lookup: only check whether each challenge has a solution
+//   --solution N   print solution N of the binary solution file and exit
+//   --checkpoint S save a checkpoint at most every S seconds (filename_board.ckp, default: 60, 0 = none)
+//   --resume       continue the search at the checkpoint of an interrupted run (with its branch, symmetry and output)
+//   --shard I/N    search only the I-th of N parts of the search tree (1 <= I <= N, balanced by estimated size),
+//                  solutions are written to filename_board_IofN.2do / .2db (checkpoint filename_board_IofN.ckp)
+//   --merge N      combine the solution files of N shards into one solution file and exit
+//   --count        count solutions only (no solution file), the number of completions of each search state
+//                  is kept in a transposition table, so states reached by different placements are only searched once
+//   --memory MB    memory budget of the transposition table (default: 256)
+//   --challenge F  solve the challenges of file F (starting positions with pre-placed parts, see IQpuzzler_bitboard.hpp),
+//                  results are written to F_board.2do / .3do (without extension of F)
+//   --limit K      stop each challenge after K solutions (default: 1, 0 = all solutions)
+//   --serve PATH   run as daemon: answer challenge queries on Unix socket PATH with the search threads,
+//                  until SIGINT or SIGTERM (binary protocol, see IQpuzzler_server.hpp)
+//   --depth D      bounded search: nodes with D parts on board are not expanded (benchmarks, not with --count)
+//   --metrics F    write counters of the search for each depth and part to JSON file F (every second and at exit),
+//                  only if compiled with SEARCH_METRICS (make -B SEARCH_METRICS=1)
+//   --stats N      print statistics of the search (nodes, placements tried, time to first and N-th solution, total time)
+//   --cpu V        instruction set of the search kernels (default: auto = best supported by the CPU, see IQpuzzler_cpu.hpp):
+//                  baseline = x86-64, bmi2 = popcnt, tzcnt and pext, avx2 = bmi2 and vector fit test
+//
+// Last update: 10/17/2026
+
+#ifndef _IQPUZZLER_OPTIONS_
+#define _IQPUZZLER_OPTIONS_
+
+#include <string>       // string
+#include <vector>       // vector
+#include "IQpuzzler_cpu.hpp"    // cpu_variant
+
+using namespace std;
+
+enum branch_mode {BRANCH_PART, BRANCH_FIRST, BRANCH_FEWEST};
+enum symmetry_mode {SYMMETRY_BREAK, SYMMETRY_DEDUP, SYMMETRY_OFF};
+enum output_format {OUTPUT_TEXT, OUTPUT_BINARY};
+
+struct options
+{
+    string name = "orig";   // input filename without extension
+    unsigned threads = 1;   // number of search threads
+    double render_hz = 10;  // refresh rate of visualization
+    bool quiet = false;     // no visualization
+    branch_mode branch = BRANCH_PART;   // selection of next search step
+    symmetry_mode symmetry = SYMMETRY_BREAK;    // handling of symmetric solutions
+    bool compile = false;   // write cache file and exit
+    output_format output = OUTPUT_TEXT;     // format of solution file
+    bool convert = false;   // convert binary solution file to text and exit
+    unsigned long solution = 0;     // print solution of binary solution file and exit (0 = none)
+    bool index = false;     // build solution index and exit
+    string lookup;          // file with challenges answered from solution index (empty = none)
+    bool exists = false;    // lookup: only check whether challenges have solutions
+    unsigned checkpoint = 60;   // minimum time between checkpoints in seconds (0 = none)
+    bool resume = false;    // continue search at checkpoint
+    unsigned shard = 1;     // part of the search tree to be searched
+    unsigned shards = 1;    // number of parts of the search tree
+    unsigned merge = 0;     // combine solution files of this number of shards and exit (0 = none)
+    bool count = false;     // count solutions only
+    unsigned long memory = 256;     // memory budget of transposition table in MB
+    string challenge;       // file with challenges (empty = search from empty board)
+    unsigned long limit = 1;    // solutions of each challenge (0 = all)
+    unsigned depth = 0;     // maximum number of parts on board (0 = complete search)
+    unsigned long stats = 0;    // print statistics with time to this solution (0 = no statistics)
+    string metrics;         // file for counters of the search (empty = none)
+    string serve;           // Unix socket of daemon (empty = no daemon)
+    vector <string> sets;   // further input filenames (piece sets of daemon)
+    cpu_variant cpu = CPU_AUTO;     // variant of search kernels
+};
+
+// parses command line, prints usage and exits on invalid arguments
+options read_options(int argc, char *argv[]);
+
+#endif
@@ -0,0 +1,248 @@
+// Generator of part orientations, replaces the MATLAB / Octave pre-processing (pre-processing/*.m).
+// A part is given by its base shape (dots x,y in the plane, as parts2d{p}{1} of the MATLAB tool).
+// 2D orientations: the base shape is turned by quarter turns (orientations 1-4), the last one is mirrored
+// and turned again (5-8). Each orientation is moved to coordinates >= 0 and its dots are sorted by x, then y,
+// so identical orientations are found by comparison and only the first one is kept.
+// Pyramid orientations (3D): the 2D orientations lie flat in the layers (coordinates stretched by 2), or upright
+// in one of the two diagonal planes x = y and x = -y of the lattice. Rotating a flat orientation into these planes
+// and stretching x,y by 2 and z by sqrt(2) (as the MATLAB tool does) maps dot (x,y) onto (x+y, -(x+y), x-y)
+// or (x+y, x+y, x-y), so the generator only needs integer arithmetic. Upright orientations are moved to coordinates >= 0,
+// and moved by one in x or y if their first dot in the bottom layer would not be at the even coordinates of the holes.
+//
+// All functions are constexpr: the part set of the original game (orig) is generated at compile time,
+// including its reductions (orientations of symmetric parts and order of the parts as in bin/orig.2di, orig.3di),
+// and the solvers use it without reading the input file. Other sets are generated at runtime (IQpuzzler_generate).
+//
+// Last update: 10/17/2026
+
+#ifndef _IQPUZZLER_ORIENTATIONS_
+#define _IQPUZZLER_ORIENTATIONS_
+
+#include "IQpuzzler_shapes.hpp"     // shape table
+#include <cstdint>      // uint8_t, int8_t, uint32_t
+#include <cstddef>      // size_t
+#include <string>       // string
+#include <ostream>      // ostream
+
+using namespace std;
+
+#define SHAPE_DOTS 16           // maximum number of dots of a generated part
+#define SHAPE_ORIENTATIONS 24   // maximum number of orientations of a part (8 in each of 3 planes)
+
+// dots of one orientation
+struct shape_dots
+{
+    uint8_t dots = 0;
+    int8_t x[SHAPE_DOTS] = {}, y[SHAPE_DOTS] = {}, z[SHAPE_DOTS] = {};
+};
+
+// all orientations of one part
+struct shape_orientations
+{
+    uint8_t count = 0;
+    shape_dots orientation[SHAPE_ORIENTATIONS] = {};
+};
+
+// orientations of a part in a built-in set: all generated orientations, or a reduced list
+struct builtin_part
+{
+    uint8_t shape;                      // base shape
+    uint8_t first;                      // orientation which is tried first (moved to the front)
+    uint8_t keep;                       // number of orientations in only (0 = all orientations)
+    uint8_t only[SHAPE_ORIENTATIONS];   // kept orientations (e.g. one orientation of a symmetric part)
+};
+
+// flat table of a built-in set, layout as shape_table (see IQpuzzler_shapes.hpp)
+template <size_t parts>
+struct builtin_table
+{
+    uint8_t partcount = parts;
+    uint32_t orientations = 0, dot_count = 0;
+    uint32_t part_begin[parts+2] = {};
+    uint8_t part[parts*SHAPE_ORIENTATIONS] = {};
+    uint8_t dots[parts*SHAPE_ORIENTATIONS] = {};
+    uint32_t first[parts*SHAPE_ORIENTATIONS] = {};
+    int8_t dx[parts*SHAPE_ORIENTATIONS*SHAPE_DOTS] = {}, dy[parts*SHAPE_ORIENTATIONS*SHAPE_DOTS] = {},
+           dz[parts*SHAPE_ORIENTATIONS*SHAPE_DOTS] = {};
+};
+
+// base shape from a list of dots {x,y}
+template <size_t n>
+constexpr shape_dots base_shape(const int8_t (&xy)[n][2])
+{
+    static_assert(n <= SHAPE_DOTS, "too many dots");
+    shape_dots s;
+    s.dots = n;
+    for (size_t i = 0; i < n; i++)
+    {
+        s.x[i] = xy[i][0];
+        s.y[i] = xy[i][1];
+    }
+    return s;
+}
+
+constexpr bool same_dots(const shape_dots & a, const shape_dots & b)
+{
+    if (a.dots != b.dots)
+        return false;
+    for (uint8_t i = 0; i < a.dots; i++)
+        if (a.x[i] != b.x[i] || a.y[i] != b.y[i] || a.z[i] != b.z[i])
+            return false;
+    return true;
+}
+
+// moves the dots to coordinates >= 0
+constexpr void shift_to_origin(shape_dots & s)
+{
+    int8_t min_x = s.x[0], min_y = s.y[0], min_z = s.z[0];
+    for (uint8_t i = 1; i < s.dots; i++)
+    {
+        min_x = s.x[i] < min_x ? s.x[i] : min_x;
+        min_y = s.y[i] < min_y ? s.y[i] : min_y;
+        min_z = s.z[i] < min_z ? s.z[i] : min_z;
+    }
+    for (uint8_t i = 0; i < s.dots; i++)
+    {
+        s.x[i] -= min_x;
+        s.y[i] -= min_y;
+        s.z[i] -= min_z;
+    }
+}
+
+// sorts the dots by x, then y (insertion sort)
+constexpr void sort_dots(shape_dots & s)
+{
+    for (uint8_t i = 1; i < s.dots; i++)
+        for (uint8_t j = i; j > 0 && (s.x[j] < s.x[j-1] || (s.x[j] == s.x[j-1] && s.y[j] < s.y[j-1])); j--)
+        {
+            int8_t x = s.x[j], y = s.y[j];
+            s.x[j] = s.x[j-1];
+            s.y[j] = s.y[j-1];
+            s.x[j-1] = x;
+            s.y[j-1] = y;
+        }
+}
+
+// distinct orientations of a base shape in the plane
+constexpr shape_orientations orientations_2d(const shape_dots & base)
+{
+    shape_orientations result;
+    shape_dots turned = base;
+
+    for (uint8_t o = 0; o < 8; o++)
+    {
+        if (o == 4)     // mirror
+            for (uint8_t i = 0; i < turned.dots; i++)
+                turned.y[i] = -turned.y[i];
+        if (o && o != 4)    // quarter turn: (x,y) -> (y,-x)
+            for (uint8_t i = 0; i < turned.dots; i++)
+            {
+                int8_t x = turned.x[i];
+                turned.x[i] = turned.y[i];
+                turned.y[i] = -x;
+            }
+        shape_dots s = turned;
+        shift_to_origin(s);
+        sort_dots(s);
+        bool found = false;
+        for (uint8_t k = 0; k < result.count && !found; k++)
+            found = same_dots(result.orientation[k], s);
+        if (!found)
+            result.orientation[result.count++] = s;
+    }
+    return result;
+}
+
+// orientations of a base shape in the pyramid lattice: flat in the layers, then upright in the planes x = y and x = -y
+constexpr shape_orientations orientations_3d(const shape_dots & base)
+{
+    shape_orientations flat = orientations_2d(base), result;
+
+    result.count = 3*flat.count;
+    for (uint8_t o = 0; o < flat.count; o++)
+    {
+        const shape_dots & f = flat.orientation[o];
+        for (uint8_t plane = 0; plane < 3; plane++)
+        {
+            shape_dots & s = result.orientation[plane*flat.count + o];
+            s.dots = f.dots;
+            for (uint8_t i = 0; i < f.dots; i++)
+            {
+                s.x[i] = plane ? f.x[i] + f.y[i] : 2*f.x[i];
+                s.y[i] = plane == 1 ? -(f.x[i] + f.y[i]) : plane == 2 ? f.x[i] + f.y[i] : 2*f.y[i];
+                s.z[i] = plane ? f.x[i] - f.y[i] : 0;
+            }
+            if (!plane)
+                continue;
+            shift_to_origin(s);
+            // first dot in the bottom layer on even coordinates
+            uint8_t bottom = 0;
+            while (s.z[bottom])
+                bottom++;
+            int8_t odd_x = s.x[bottom] & 1, odd_y = s.y[bottom] & 1;
+            for (uint8_t i = 0; i < s.dots; i++)
+            {
+                s.x[i] += odd_x;
+                s.y[i] += odd_y;
+            }
+        }
+    }
+    return result;
+}
+
+// orientations of a part of a built-in set
+constexpr shape_orientations select_orientations(const shape_orientations & all, const builtin_part & p)
+{
+    shape_orientations result;
+
+    result.orientation[result.count++] = all.orientation[p.first];
+    for (uint8_t k = 0; k < (p.keep ? p.keep : all.count); k++)
+    {
+        uint8_t o = p.keep ? p.only[k] : k;
+        if (o != p.first)
+            result.orientation[result.count++] = all.orientation[o];
+    }
+    return result;
+}
+
+// generates the flat table of a built-in set from base shapes and the parts of the set
+template <size_t parts>
+constexpr builtin_table<parts> builtin_orientations(const shape_dots shapes[], const builtin_part (&set)[parts], uint8_t dimensions)
+{
+    builtin_table<parts> table;
+
+    for (size_t p = 0; p < parts; p++)
+    {
+        shape_orientations all = dimensions == 3 ? orientations_3d(shapes[set[p].shape]) : orientations_2d(shapes[set[p].shape]);
+        shape_orientations selected = select_orientations(all, set[p]);
+        table.part_begin[p+1] = table.orientations;
+        for (uint8_t o = 0; o < selected.count; o++)
+        {
+            const shape_dots & s = selected.orientation[o];
+            table.part[table.orientations] = p+1;
+            table.dots[table.orientations] = s.dots;
+            table.first[table.orientations] = table.dot_count;
+            table.orientations++;
+            for (uint8_t i = 0; i < s.dots; i++, table.dot_count++)
+            {
+                table.dx[table.dot_count] = s.x[i];
+                table.dy[table.dot_count] = s.y[i];
+                table.dz[table.dot_count] = s.z[i];
+            }
+        }
+    }
+    table.part_begin[parts+1] = table.orientations;
+    return table;
+}
+
+// fills shapes with the built-in set name for dots with dimensions coordinates (2 or 3), returns false if there is none
+bool builtin_shapes(const string & name, uint8_t dimensions, shape_table & shapes);
+
+// generates all orientations of the parts in bases (first orientation of each part = base shape) into shapes,
+// returns an error message (empty if successful)
+string generate_shapes(const shape_table & bases, uint8_t dimensions, shape_table & shapes);
+
+// writes shapes in the format of the input files (*.2di, *.3di)
+void write_shapes(ostream & out, const shape_table & shapes, uint8_t dimensions);
+
+#endif
@@ -1,29 +1,32 @@
-// Reads text file (*.2di, *.3di) for IQpuzzler and fills vector array with data.
+// Reads text file (*.2di, *.3di) for IQpuzzler and fills the shape table (see IQpuzzler_shapes.hpp) with its data.
 // Expected format is a list of parts (separated by ','),
 // where each part is a list of orientations ( start of list with '[', end of list with ']'),
-// where each orientation is a list of dots (logically same number of dots within same part, usually 3 to 5, depending on part size),
-// where each dot is a list of coordinates (single digit, non-negative integers, x,y, optional z for 3D puzzle),
+// where each orientation is a list of dots (same number of dots within same part, usually 3 to 5, depending on part size),
+// where each dot is a list of coordinates (single digit, non-negative integers, x,y, plus z for 3D puzzle),
 // defining the possible geometric orientations of each dot of the parts.
 // Thus, the text in the file can also be used directly in Python or C++ (replace [] by {}) to initialize lists / vector arrays.
 //
-// No checks are performed to verify correctness of the data (except counting the number of parts).
-// Wrong data or format will lead to undefined behaviour of the read functions or the solution algorithm.
-// Characters other than begin of list '[', end of list ']', separator ',' or single digits will be ignored and can be used for comments.
+// The whole file is read into one buffer and parsed in a single pass, the dots are appended to the flat shape table.
+// Blanks, line breaks and comments (from "//" to end of line) are skipped, any other character outside this format
+// is reported with line and column (e.g. missing brackets, dots with wrong number of coordinates,
+// orientations with a different number of dots than the first orientation of the part, multi-digit coordinates),
+// and the program exits.
 //
-// Input files can be created automatically with the provided MATLAB / Octave tool
-// for different game configurations (e.g. original IQpuzzlerPRO game).
+// Input files can be created automatically from the base shapes of the parts with IQpuzzler_generate
+// (see IQpuzzler_orientations.hpp), the original game is built into the solvers.
 //
 // Written by Stefan Abendroth (sab@ab-solut.com)
-// Last update: 03/06/2022
+// Last update: 10/17/2026
 
 #ifndef _IQPUZZLER_READ_INPUT_
 #define _IQPUZZLER_READ_INPUT_
 
+#include "IQpuzzler_shapes.hpp"     // shape table
 #include <cstdint>      // uint8_t
 #include <vector>       // vector
 #include <string>       // string
 #include <iostream>     // cout, endl
-#include <fstream>      // fopen, fclose
+#include <fstream>      // ifstream, ofstream
 #include <chrono>       // create timestamps
 #include <sys/ioctl.h>  // get size of terminal window
 
@@ -33,10 +36,8 @@
 
 using namespace std;
 
-uint8_t read_number(ifstream& partfile);
-vector <uint8_t> read_dot(ifstream& partfile);
-vector <vector <uint8_t> > read_orientation(ifstream& partfile);
-vector <vector <vector <uint8_t> > > read_part(ifstream& partfile);
-uint8_t read_input(string inputfile, vector <vector <vector <vector <uint8_t> > > > & part);
+// reads all parts of input file with dots of given number of coordinates (2 or 3) into shapes, returns number of parts
+// (prints error with line and column and exits if file is missing or invalid)
+uint8_t read_input(const string & inputfile, shape_table & shapes, uint8_t dimensions);
 
-#endif
\ No newline at end of file
+#endif
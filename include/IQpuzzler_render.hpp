@@ -0,0 +1,38 @@
+// Terminal visualization of the current search, decoupled from the search threads.
+// The renderer runs in its own thread and samples a snapshot of the board at a fixed rate (--render-hz):
+// it raises render_request, the next search step that sees the request publishes its board (render_publish).
+// Publishing never blocks: if the renderer is just reading the previous snapshot, the step is skipped.
+// Only fields that changed since the last frame are redrawn (ANSI escape codes).
+// A status line below the board shows the number of solutions found so far.
+//
+// Last update: 10/17/2026
+
+#ifndef _IQPUZZLER_RENDER_
+#define _IQPUZZLER_RENDER_
+
+#include <cstdint>      // uint8_t, uint16_t, uint64_t
+#include <vector>       // vector
+#include <string>       // string
+#include <atomic>       // atomic
+
+using namespace std;
+
+// terminal position of a board field (row, column, 1-based)
+struct screen_position
+{
+    uint16_t row;
+    uint16_t col;
+};
+
+extern atomic <bool> render_request;    // set by renderer, polled by search threads
+
+// starts renderer thread for a board with layout[field] positions, colors for each part number (0 = empty)
+// and status line in given terminal row
+void start_renderer(const vector <screen_position> & layout, const vector <string> & color, uint16_t status_row,
+                    double hz, const atomic <uint64_t> * solutions);
+// draws final frame and stops renderer thread (no effect if renderer was not started)
+void stop_renderer();
+// hands over snapshot of board (part number for each field), called by search threads if render_request is set
+void render_publish(const uint8_t cells[]);
+
+#endif
@@ -0,0 +1,67 @@
+// Solver daemon on a Unix domain socket (--serve PATH), see IQpuzzler_bitboard.hpp.
+// The daemon keeps the placement tables of its piece sets (input files) in memory and answers challenge queries.
+//
+// Protocol (binary, byte order of the host, any number of queries per connection):
+// query:  query header, followed by 'count' pre-placed parts (query_placement: part, orientation, layer, row, col,
+//         as in challenge files, see IQpuzzler_options.hpp)
+// answer: answer header, followed by 'partcount' placements for each solution (all parts, pre-placed parts first)
+// Answers carry the id of their query, a connection with several open queries may receive them in any order.
+//
+// Each connection has a reader thread which queues the queries with their time of receipt. The worker threads of the pool
+// take the queries one at a time and send each answer as soon as it is ready, so a burst of queries is spread over all
+// workers. The time budget of a query starts when it is received (waiting in the queue counts against the budget).
+// The daemon stops on SIGINT or SIGTERM.
+//
+// Last update: 10/17/2026
+
+#ifndef _IQPUZZLER_SERVER_
+#define _IQPUZZLER_SERVER_
+
+#include <cstdint>      // uint8_t, uint16_t, uint32_t
+#include <string>       // string
+#include <vector>       // vector
+#include <functional>   // function
+#include <chrono>       // steady_clock
+
+using namespace std;
+
+#define SERVER_MAX_PARTS 16     // maximum number of pre-placed parts of a query
+
+enum answer_status {ANSWER_COMPLETE, ANSWER_LIMIT, ANSWER_TIMEOUT, ANSWER_INVALID};
+
+struct query
+{
+    uint32_t id;            // chosen by client, returned with answer
+    uint8_t set;            // piece set (input file, in order of command line, from 0)
+    uint8_t count;          // number of pre-placed parts
+    uint16_t limit;         // maximum number of solutions (0 = 65535)
+    uint32_t budget;        // time budget in us from receipt of the query (0 = unlimited)
+};
+
+struct query_placement
+{
+    uint8_t part;           // 1 = A, 2 = B, ...
+    uint8_t orientation;    // in order of the input file, from 0
+    uint8_t layer;
+    uint8_t row;
+    uint8_t col;
+};
+
+struct answer
+{
+    uint32_t id;            // id of query
+    uint8_t status;         // answer_status: search complete, stopped at limit or at time budget, or query invalid
+    uint8_t partcount;      // placements per solution
+    uint16_t solutions;     // number of solutions
+    uint32_t time;          // time from receipt of the query to its answer in us (waiting and search)
+};
+
+// solves a query received at the given time, appends answer (header and solutions) to reply
+typedef function <void(const query & q, const query_placement parts[], chrono::steady_clock::time_point received,
+                       vector <uint8_t> & reply)> query_handler;
+
+// listens on Unix socket path and answers queries with the given number of worker threads until SIGINT or SIGTERM,
+// returns number of queries answered (prints error and returns 0 if the socket can't be opened)
+uint64_t run_server(const string & path, unsigned threads, const query_handler & handler);
+
+#endif
@@ -0,0 +1,59 @@
+// Flat table of part orientations, filled by the parser of the input file (see IQpuzzler_read_input.hpp).
+// The shape table stores the parts as structure of arrays in contiguous, cache-aligned memory:
+// one entry per orientation (part number, dot count, index of first dot), one entry per dot (offsets x,y,z).
+// Orientations are stored in the order of the input file, so the orientations of each part are contiguous.
+//
+// Last update: 10/17/2026
+
+#ifndef _IQPUZZLER_SHAPES_
+#define _IQPUZZLER_SHAPES_
+
+#include <cstdint>      // uint8_t, int8_t, uint32_t
+#include <cstdlib>      // aligned_alloc, free
+#include <new>          // bad_alloc
+#include <vector>       // vector
+
+using namespace std;
+
+#define CACHE_LINE 64
+
+// allocator for vectors whose data starts at a cache line boundary
+template <typename T>
+struct cache_aligned
+{
+    typedef T value_type;
+
+    cache_aligned() = default;
+    template <typename U> cache_aligned(const cache_aligned<U> &) {}
+
+    T* allocate(size_t n)
+    {
+        // size has to be a multiple of the alignment
+        void* p = aligned_alloc(CACHE_LINE, (n*sizeof(T) + CACHE_LINE-1) / CACHE_LINE * CACHE_LINE);
+        if (!p)
+            throw bad_alloc();
+        return (T*)p;
+    }
+    void deallocate(T* p, size_t) { free(p); }
+};
+template <typename T, typename U> bool operator==(const cache_aligned<T> &, const cache_aligned<U> &) { return true; }
+template <typename T, typename U> bool operator!=(const cache_aligned<T> &, const cache_aligned<U> &) { return false; }
+
+template <typename T>
+using aligned_vector = vector <T, cache_aligned<T> >;
+
+// part orientations of an input file
+struct shape_table
+{
+    uint8_t partcount = 0;
+    vector <uint32_t> part_begin;       // first orientation of each part (part_begin[partcount+1] = number of orientations)
+    aligned_vector <uint8_t> part;      // part number of each orientation
+    aligned_vector <uint8_t> dots;      // number of dots of each orientation
+    aligned_vector <uint32_t> first;    // index of first dot of each orientation
+    aligned_vector <int8_t> dx, dy, dz; // offsets of each dot from the origin of its orientation (dz = 0 for 2D parts)
+
+    size_t orientations() const { return part.size(); }
+    uint8_t size(uint8_t part_number) const { return dots[part_begin[part_number]]; }
+};
+
+#endif
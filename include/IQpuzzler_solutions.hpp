@@ -0,0 +1,85 @@
+// Binary solution files (*.2db, *.3db), see IQpuzzler_bitboard.hpp.
+// Each solution is stored as a short code of its placements, which is built and decoded by the solver
+// with its placement table (the file only knows the length of each code).
+// Each solution starts with one byte: the length of its code in bytes (bits 0..6) and a flag (bit 7) for a time stamp,
+// followed by the increase of the time stamp in seconds (if flagged, 7 bits per byte, low bits first) and the code.
+// The solutions are grouped into blocks of SOLUTION_BLOCK solutions, the time stamps of each block count from 0.
+// An index at the end of the file holds the offset of each block,
+// so any solution is decoded from the start of its block without reading the rest of the file.
+// The header holds the board and a hash of the placement table, which is needed to decode the codes.
+//
+// Last update: 10/17/2026
+
+#ifndef _IQPUZZLER_SOLUTIONS_
+#define _IQPUZZLER_SOLUTIONS_
+
+#include <cstdint>      // uint8_t, uint16_t, uint32_t, uint64_t
+#include <cstddef>      // size_t
+#include <string>       // string
+#include <vector>       // vector
+#include <fstream>      // ofstream, ifstream
+
+using namespace std;
+
+#define SOLUTION_MAGIC "IQPZSOL"
+#define SOLUTION_VERSION 1
+#define SOLUTION_BLOCK 256      // solutions per block
+#define SOLUTION_LENGTH 0x7f    // length of code in first byte of solution
+#define SOLUTION_TIME 0x80      // time stamp follows
+
+struct solution_header
+{
+    char magic[8];          // SOLUTION_MAGIC
+    uint32_t version;       // SOLUTION_VERSION
+    char board[8];          // name of board geometry
+    uint8_t symmetry;       // symmetry mode of the placement table
+    uint8_t partcount;
+    uint16_t block;         // solutions per block
+    uint64_t hash;          // hash of the placement table
+    uint64_t solutions;     // number of solutions
+    uint64_t index;         // offset of block index
+    uint64_t size;          // size of file
+};
+
+// writes solutions to a binary solution file
+class solution_writer
+{
+public:
+    bool open(const string & filename, const solution_header & header);
+    // continues a solution file after its first solutions (size offset), drops the rest of the file
+    bool reopen(const string & filename, uint64_t offset, uint64_t solutions);
+    void add(const uint8_t code[], uint8_t length, uint32_t seconds);
+    uint64_t flush();       // writes buffered solutions to file, returns size of file (without block index)
+    bool close();           // writes block index and header, closes file
+
+private:
+    ofstream file;
+    solution_header header;
+    vector <uint64_t> blocks;   // offset of each block
+    uint32_t previous_seconds = 0;
+    uint64_t size = 0;
+};
+
+// read-only memory mapping of a binary solution file
+class solution_reader
+{
+public:
+    ~solution_reader();
+    // maps file, returns header or nullptr if file is missing or invalid
+    const solution_header * open(const string & filename);
+    // returns code and time stamp of solution n (0-based), or nullptr if the file is corrupt
+    const uint8_t * get(uint64_t n, uint8_t & length, uint32_t & seconds) const;
+    // returns code and time stamp of the solution after the previous one (sequential reading), or nullptr at end of file
+    const uint8_t * next(uint8_t & length, uint32_t & seconds);
+
+private:
+    const uint8_t * base = nullptr;
+    size_t length = 0;
+    const solution_header * header = nullptr;
+    uint64_t current = 0;   // next solution for sequential reading
+    uint64_t offset = 0;    // position of next solution
+
+    const uint8_t * decode(uint64_t & position, uint8_t & length, uint32_t & seconds) const;
+};
+
+#endif
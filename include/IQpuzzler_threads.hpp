@@ -0,0 +1,22 @@
+// Work-stealing thread pool for parallel search.
+// The search tree is split at the first part levels into independent tasks, numbered in sequential search order.
+// Tasks are dealt round-robin to the workers. Each worker takes tasks from the front of its own queue
+// and steals from the back of the other queues when its own queue is empty.
+// Finished tasks are handed over to the calling thread strictly in task order,
+// so results of the workers can be merged deterministically (same order as sequential search).
+//
+// Last update: 10/17/2026
+
+#ifndef _IQPUZZLER_THREADS_
+#define _IQPUZZLER_THREADS_
+
+#include <cstddef>      // size_t
+#include <functional>   // function
+
+using namespace std;
+
+// runs work(task) for all tasks on the given number of threads
+// and calls merge(task) in the calling thread for task 0,1,2,... as soon as they are finished
+void run_tasks(size_t taskcount, unsigned threads, const function <void(size_t)> & work, const function <void(size_t)> & merge);
+
+#endif
@@ -0,0 +1,78 @@
+// Binary cache files with compiled placement tables.
+//
+// Last update: 10/17/2026
+
+#include "IQpuzzler_cache.hpp"
+
+#include <cstring>      // memcmp
+#include <sys/mman.h>   // mmap, munmap
+#include <sys/stat.h>   // stat
+#include <fcntl.h>      // open
+#include <unistd.h>     // close
+
+bool cache_writer::open(const string & filename)
+{
+    cache_header header = {};
+
+    file.open(filename, ios::binary | ios::trunc);
+    size = 0;
+    section(&header, sizeof(header));   // placeholder, header is written by close()
+    return file.good();
+}
+
+void cache_writer::section(const void * data, size_t bytes)
+{
+    static const char padding[CACHE_SECTION] = {};
+    size_t padded = (bytes + CACHE_SECTION-1) / CACHE_SECTION * CACHE_SECTION;
+
+    file.write((const char *)data, bytes);
+    file.write(padding, padded - bytes);
+    size += padded;
+}
+
+bool cache_writer::close(cache_header & header)
+{
+    memcpy(header.magic, CACHE_MAGIC, sizeof(header.magic));
+    header.version = CACHE_VERSION;
+    header.size = size;
+    file.seekp(0);
+    file.write((const char *)&header, sizeof(header));
+    file.close();
+    return !file.fail();
+}
+
+cache_reader::~cache_reader()
+{
+    if (base)
+        munmap((void *)base, length);
+}
+
+const cache_header * cache_reader::open(const string & filename, const string & source)
+{
+    struct stat cache_stat, source_stat;
+    const cache_header * header;
+    int fd;
+
+    if (stat(filename.c_str(), &cache_stat) || stat(source.c_str(), &source_stat))
+        return nullptr;
+    if (cache_stat.st_mtim.tv_sec < source_stat.st_mtim.tv_sec ||
+        (cache_stat.st_mtim.tv_sec == source_stat.st_mtim.tv_sec && cache_stat.st_mtim.tv_nsec <= source_stat.st_mtim.tv_nsec))
+        return nullptr;     // input file changed after compilation
+    if ((size_t)cache_stat.st_size < sizeof(cache_header))
+        return nullptr;
+
+    fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return nullptr;
+    void * map = mmap(nullptr, cache_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED)
+        return nullptr;
+    base = (const uint8_t *)map;
+    length = cache_stat.st_size;
+
+    header = section<cache_header>(1);
+    if (memcmp(header->magic, CACHE_MAGIC, sizeof(header->magic)) || header->version != CACHE_VERSION || header->size != length)
+        return nullptr;
+    return header;
+}
@@ -0,0 +1,31 @@
+// Checkpoint files of a running search.
+//
+// Last update: 10/17/2026
+
+#include "IQpuzzler_checkpoint.hpp"
+
+#include <cstring>      // memcpy, memcmp
+#include <cstdio>       // rename
+#include <fstream>      // ifstream, ofstream
+
+bool write_checkpoint(const string & filename, checkpoint & point)
+{
+    string temporary = filename + ".tmp";
+    ofstream file(temporary, ios::binary | ios::trunc);
+
+    memcpy(point.magic, CHECKPOINT_MAGIC, sizeof(point.magic));
+    point.version = CHECKPOINT_VERSION;
+    file.write((const char *)&point, sizeof(point));
+    file.close();
+    return !file.fail() && !rename(temporary.c_str(), filename.c_str());
+}
+
+bool read_checkpoint(const string & filename, checkpoint & point)
+{
+    ifstream file(filename, ios::binary);
+
+    if (!file.read((char *)&point, sizeof(point)))
+        return false;
+    return !memcmp(point.magic, CHECKPOINT_MAGIC, sizeof(point.magic)) && point.version == CHECKPOINT_VERSION
+           && point.depth <= CHECKPOINT_LEVELS;
+}
@@ -0,0 +1,204 @@
+// Inner kernels of the bitboard search in several instruction set variants, selected at startup.
+// The kernel bodies are written once and inlined into a function per variant, which is compiled
+// for the instruction set extensions of the variant (popcount and count trailing zeros become single instructions).
+//
+// Last update: 10/17/2026
+
+#include "IQpuzzler_cpu.hpp"
+
+#ifdef __x86_64__      // (_pext_u64 only exists in 64 bit mode)
+#include <immintrin.h>  // _pext_u64, AVX2 intrinsics
+#define KERNEL_X86
+#endif
+
+#define KERNEL_BODY static inline __attribute__((always_inline))
+
+KERNEL_BODY uint8_t first_field_body(const uint64_t lines[], size_t count, uint64_t mask)
+{
+    for (size_t line = 0; line < count; line++)
+        if (mask & lines[line])
+            return __builtin_ctzll(mask & lines[line]);
+    return 0;
+}
+
+KERNEL_BODY unsigned fill_region_body(const uint64_t neighbours[], uint64_t & region, uint64_t free, unsigned limit, bool & open)
+{
+    uint64_t frontier = region, grow;
+    unsigned size = __builtin_popcountll(region);
+
+    while (frontier && size < limit)
+    {
+        grow = 0;
+        for (; frontier; frontier &= frontier-1)
+            grow |= neighbours[__builtin_ctzll(frontier)];
+        frontier = grow & free & ~region;
+        region |= frontier;
+        size = __builtin_popcountll(region);
+    }
+    open = frontier != 0;
+    return size;
+}
+
+KERNEL_BODY bool cavity_body(const uint64_t plane_neighbours[], const uint64_t next_field[], const uint64_t further[],
+                             unsigned planes, uint64_t free, uint64_t check)
+{
+    uint64_t open, plane_free;
+    unsigned i, directions = 4*planes;
+
+    for (check &= free; check; check &= check-1)
+    {
+        i = __builtin_ctzll(check);
+        // several free neighbours on one plane?
+        open = 0;
+        for (unsigned plane = 0; plane < planes; plane++)
+        {
+            plane_free = plane_neighbours[i*planes + plane] & free;
+            open |= plane_free & (plane_free - 1);
+        }
+        // further neighbour space on same plane allows more parts to be placed
+        for (unsigned d = 0; d < directions && !open; d++)
+            if (next_field[i*directions + d] & free)
+                open = further[i*directions + d] & free;
+        if (!open)
+            return true;
+    }
+    return false;
+}
+
+KERNEL_BODY uint64_t fits_body(const uint64_t mask[], const uint8_t part[], size_t count, uint64_t occupied, uint16_t remaining)
+{
+    uint64_t result = 0;
+
+    for (size_t i = 0; i < count; i++)
+        result |= (uint64_t)((remaining >> part[i] & 1) & !(occupied & mask[i])) << i;
+    return result;
+}
+
+// baseline x86-64 (or other architectures)
+
+uint64_t extract_baseline(uint64_t x, uint64_t mask)
+{
+    uint64_t result = 0;
+    for (uint64_t bit = 1; mask; mask &= mask-1, bit <<= 1)
+        if (x & mask & (~mask+1))
+            result |= bit;
+    return result;
+}
+
+uint8_t first_field_baseline(const uint64_t lines[], size_t count, uint64_t mask)
+{
+    return first_field_body(lines, count, mask);
+}
+
+unsigned fill_region_baseline(const uint64_t neighbours[], uint64_t & region, uint64_t free, unsigned limit, bool & open)
+{
+    return fill_region_body(neighbours, region, free, limit, open);
+}
+
+bool cavity_baseline(const uint64_t plane_neighbours[], const uint64_t next_field[], const uint64_t further[],
+                     unsigned planes, uint64_t free, uint64_t check)
+{
+    return cavity_body(plane_neighbours, next_field, further, planes, free, check);
+}
+
+uint64_t fits_baseline(const uint64_t mask[], const uint8_t part[], size_t count, uint64_t occupied, uint16_t remaining)
+{
+    return fits_body(mask, part, count, occupied, remaining);
+}
+
+#ifdef KERNEL_X86
+
+#define TARGET_BMI2 __attribute__((target("popcnt,bmi,bmi2")))
+#define TARGET_AVX2 __attribute__((target("popcnt,bmi,bmi2,avx2")))
+
+// popcnt, tzcnt and pext
+
+TARGET_BMI2 uint64_t extract_bmi2(uint64_t x, uint64_t mask)
+{
+    return _pext_u64(x, mask);
+}
+
+TARGET_BMI2 uint8_t first_field_bmi2(const uint64_t lines[], size_t count, uint64_t mask)
+{
+    return first_field_body(lines, count, mask);
+}
+
+TARGET_BMI2 unsigned fill_region_bmi2(const uint64_t neighbours[], uint64_t & region, uint64_t free, unsigned limit, bool & open)
+{
+    return fill_region_body(neighbours, region, free, limit, open);
+}
+
+TARGET_BMI2 bool cavity_bmi2(const uint64_t plane_neighbours[], const uint64_t next_field[], const uint64_t further[],
+                             unsigned planes, uint64_t free, uint64_t check)
+{
+    return cavity_body(plane_neighbours, next_field, further, planes, free, check);
+}
+
+TARGET_BMI2 uint64_t fits_bmi2(const uint64_t mask[], const uint8_t part[], size_t count, uint64_t occupied, uint16_t remaining)
+{
+    return fits_body(mask, part, count, occupied, remaining);
+}
+
+// fit test of four placements per step: AND with the board and comparison with zero,
+// part numbers are widened to 64 bit and shift the set of remaining parts (variable shift per lane)
+TARGET_AVX2 uint64_t fits_avx2(const uint64_t mask[], const uint8_t part[], size_t count, uint64_t occupied, uint16_t remaining)
+{
+    const __m256i board = _mm256_set1_epi64x(occupied), parts = _mm256_set1_epi64x(remaining);
+    const __m256i zero = _mm256_setzero_si256(), one = _mm256_set1_epi64x(1);
+    uint64_t result = 0;
+    size_t i = 0;
+
+    for (; i+4 <= count; i += 4)
+    {
+        int32_t numbers;
+        __builtin_memcpy(&numbers, part + i, sizeof(numbers));
+        __m256i masks = _mm256_loadu_si256((const __m256i *)(mask + i));
+        __m256i free = _mm256_cmpeq_epi64(_mm256_and_si256(masks, board), zero);
+        __m256i left = _mm256_and_si256(_mm256_srlv_epi64(parts, _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(numbers))), one);
+        __m256i fit = _mm256_and_si256(free, _mm256_cmpeq_epi64(left, one));
+        result |= (uint64_t)_mm256_movemask_pd(_mm256_castsi256_pd(fit)) << i;
+    }
+    if (i < count)
+        result |= fits_body(mask + i, part + i, count - i, occupied, remaining) << i;
+    return result;
+}
+
+#endif
+
+constexpr search_kernels baseline_kernels = {CPU_BASELINE, "baseline", extract_baseline, first_field_baseline, fill_region_baseline,
+                                             cavity_baseline, fits_baseline};
+#ifdef KERNEL_X86
+constexpr search_kernels bmi2_kernels = {CPU_BMI2, "bmi2", extract_bmi2, first_field_bmi2, fill_region_bmi2, cavity_bmi2, fits_bmi2};
+constexpr search_kernels avx2_kernels = {CPU_AVX2, "avx2", extract_bmi2, first_field_bmi2, fill_region_bmi2, cavity_bmi2, fits_avx2};
+#endif
+
+search_kernels kernels = baseline_kernels;
+
+cpu_variant detect_cpu()
+{
+#ifdef KERNEL_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("popcnt") && __builtin_cpu_supports("bmi") && __builtin_cpu_supports("bmi2"))
+        return __builtin_cpu_supports("avx2") ? CPU_AVX2 : CPU_BMI2;
+#endif
+    return CPU_BASELINE;
+}
+
+bool select_kernels(cpu_variant variant)
+{
+    cpu_variant best = detect_cpu();
+
+    if (variant == CPU_AUTO)
+        variant = best;
+    if (variant > best)
+        return false;
+#ifdef KERNEL_X86
+    if (variant == CPU_AVX2)
+        kernels = avx2_kernels;
+    else if (variant == CPU_BMI2)
+        kernels = bmi2_kernels;
+    else
+#endif
+        kernels = baseline_kernels;
+    return true;
+}
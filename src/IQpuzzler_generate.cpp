@@ -0,0 +1,53 @@
+// Generates the input files of a part set for the IQpuzzler solvers (replaces the MATLAB / Octave tool in pre-processing).
+// Usage: IQpuzzler_generate source name
+// source: input file (2D syntax, see IQpuzzler_read_input.hpp) whose first orientation of each part is its base shape,
+//         or a built-in set (orig, with its reductions)
+// Writes name.2di with the distinct orientations of each part in the plane and name.3di with the orientations
+// in the pyramid lattice (see IQpuzzler_orientations.hpp).
+//
+// Last update: 10/17/2026
+
+#include "IQpuzzler_orientations.hpp"   // orientation generator
+#include "IQpuzzler_read_input.hpp"     // input files
+
+int main(int argc, char *argv[])
+{
+    shape_table bases, shapes;
+
+    if (argc != 3)
+    {
+        cerr << "Usage: " << argv[0] << " source name" << endl;
+        return 1;
+    }
+    string source = argv[1], name = argv[2];
+    bool builtin = builtin_shapes(source, 2, shapes);
+    if (!builtin)
+        read_input(source, bases, 2);
+
+    for (uint8_t dimensions = 2; dimensions <= 3; dimensions++)
+    {
+        string outputfile = name + (dimensions == 2 ? ".2di" : ".3di");
+        if (builtin)
+            builtin_shapes(source, dimensions, shapes);
+        else
+        {
+            string error = generate_shapes(bases, dimensions, shapes);
+            if (error.size())
+            {
+                cerr << source << ": error: " << error << endl;
+                return 1;
+            }
+        }
+        ofstream out(outputfile);
+        write_shapes(out, shapes, dimensions);
+        out.close();
+        if (out.fail())
+        {
+            cerr << "Can't write " << outputfile << "." << endl;
+            return 1;
+        }
+        cout << to_string(shapes.orientations()) << " orientations of " << to_string(shapes.partcount)
+             << " parts written to " << outputfile << "." << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,192 @@
+// Indexed solution database: sets of solutions for each placement and for each field and part.
+//
+// Last update: 10/17/2026
+
+#include "IQpuzzler_index.hpp"
+
+#include <fstream>      // ofstream
+#include <algorithm>    // sort, lower_bound, min
+#include <cstring>      // memcpy, memcmp
+#include <sys/mman.h>   // mmap, munmap
+#include <sys/stat.h>   // stat
+#include <fcntl.h>      // open
+#include <unistd.h>     // close
+
+#define INDEX_SECTION 64    // alignment of directory, words and positions
+
+inline uint64_t align_section(uint64_t offset)
+{
+    return (offset + INDEX_SECTION-1) / INDEX_SECTION * INDEX_SECTION;
+}
+
+void index_writer::init(uint32_t sets)
+{
+    positions.assign(sets, vector <uint32_t>());
+    words.assign(sets, vector <uint64_t>());
+}
+
+void index_writer::add(uint32_t set, uint64_t solution)
+{
+    uint32_t position = solution / 64;
+
+    if (positions[set].empty() || positions[set].back() != position)
+    {
+        positions[set].push_back(position);
+        words[set].push_back(0);
+    }
+    words[set].back() |= (uint64_t)1 << (solution % 64);
+}
+
+bool index_writer::write(const string & filename, index_header & header)
+{
+    static const char padding[INDEX_SECTION] = {};
+    uint32_t bitset_words = (header.solutions + 63) / 64;
+    vector <index_set> directory(positions.size());
+    ofstream file(filename, ios::binary | ios::trunc);
+
+    // a set is stored dense if its nonzero words and their positions need more space than the whole bitset
+    header.words = header.positions = 0;
+    for (size_t s = 0; s < directory.size(); s++)
+    {
+        directory[s].word = header.words;
+        directory[s].position = header.positions;
+        directory[s].solutions = 0;
+        for (size_t i = 0; i < words[s].size(); i++)
+            directory[s].solutions += __builtin_popcountll(words[s][i]);
+        directory[s].dense = positions[s].size() * (sizeof(uint64_t) + sizeof(uint32_t)) > bitset_words * sizeof(uint64_t);
+        directory[s].words = directory[s].dense ? bitset_words : positions[s].size();
+        header.words += directory[s].words;
+        header.positions += directory[s].dense ? 0 : directory[s].words;
+    }
+    memcpy(header.magic, INDEX_MAGIC, sizeof(header.magic));
+    header.version = INDEX_VERSION;
+    header.sets = directory.size();
+    header.size = align_section(align_section(align_section(sizeof(header)) + directory.size() * sizeof(index_set))
+                                + header.words * sizeof(uint64_t)) + header.positions * sizeof(uint32_t);
+
+    file.write((const char *)&header, sizeof(header));
+    file.write(padding, align_section(sizeof(header)) - sizeof(header));
+    file.write((const char *)directory.data(), directory.size() * sizeof(index_set));
+    file.write(padding, align_section(file.tellp()) - (uint64_t)file.tellp());
+    for (size_t s = 0; s < directory.size(); s++)
+        if (directory[s].dense)
+        {
+            vector <uint64_t> bitset(bitset_words, 0);
+            for (size_t i = 0; i < positions[s].size(); i++)
+                bitset[positions[s][i]] = words[s][i];
+            file.write((const char *)bitset.data(), bitset.size() * sizeof(uint64_t));
+        }
+        else
+            file.write((const char *)words[s].data(), words[s].size() * sizeof(uint64_t));
+    file.write(padding, align_section(file.tellp()) - (uint64_t)file.tellp());
+    for (size_t s = 0; s < directory.size(); s++)
+        if (!directory[s].dense)
+            file.write((const char *)positions[s].data(), positions[s].size() * sizeof(uint32_t));
+    file.close();
+    return !file.fail();
+}
+
+index_reader::~index_reader()
+{
+    if (base)
+        munmap((void *)base, length);
+}
+
+const index_header * index_reader::open(const string & filename)
+{
+    struct stat file_stat;
+    uint64_t offset;
+    int fd;
+
+    if (stat(filename.c_str(), &file_stat) || (size_t)file_stat.st_size < sizeof(index_header))
+        return nullptr;
+    fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return nullptr;
+    void * map = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED)
+        return nullptr;
+    base = (const uint8_t *)map;
+    length = file_stat.st_size;
+    header = (const index_header *)base;
+    if (memcmp(header->magic, INDEX_MAGIC, sizeof(header->magic)) || header->version != INDEX_VERSION || header->size != length)
+        return nullptr;
+
+    offset = align_section(sizeof(index_header));
+    set = (const index_set *)(base + offset);
+    offset = align_section(offset + header->sets * sizeof(index_set));
+    words = (const uint64_t *)(base + offset);
+    offset = align_section(offset + header->words * sizeof(uint64_t));
+    positions = (const uint32_t *)(base + offset);
+    if (offset + header->positions * sizeof(uint32_t) != length)
+        return nullptr;
+    return header;
+}
+
+// intersects the sets word by word along the smallest set, counts its solutions and collects the first ones,
+// stops at the first solution if first is set
+uint64_t index_reader::scan(const uint32_t sets[], size_t count, uint64_t limit, vector <uint64_t> * found, bool first) const
+{
+    uint32_t order[INDEX_MAX_SETS];
+    size_t cursor[INDEX_MAX_SETS] = {};     // current word of each sparse set
+    uint64_t total = 0;
+
+    if (!count)
+    {   // no restriction: all solutions
+        for (uint64_t n = 0; found && n < header->solutions && (!limit || found->size() < limit); n++)
+            found->push_back(n);
+        return header->solutions;
+    }
+    count = min(count, (size_t)INDEX_MAX_SETS);
+    copy(sets, sets + count, order);
+    sort(order, order + count, [&](uint32_t a, uint32_t b) { return set[a].solutions < set[b].solutions; });
+
+    const index_set & smallest = set[order[0]];
+    for (uint32_t i = 0; i < smallest.words; i++)
+    {
+        uint32_t position = smallest.dense ? i : positions[smallest.position + i];
+        uint64_t word = words[smallest.word + i];
+        for (size_t k = 1; k < count && word; k++)
+        {
+            const index_set & other = set[order[k]];
+            if (other.dense)
+            {
+                word &= words[other.word + position];
+                continue;
+            }
+            // positions increase, so the search continues at the last word found (exponential, then binary search)
+            const uint32_t * p = positions + other.position;
+            size_t & c = cursor[k];
+            if (c < other.words && p[c] < position)
+            {
+                size_t step = 1;
+                while (c + step < other.words && p[c + step] < position)
+                {
+                    c += step;
+                    step *= 2;
+                }
+                c = lower_bound(p + c + 1, p + min(c + step + 1, (size_t)other.words), position) - p;
+            }
+            word = c < other.words && p[c] == position ? word & words[other.word + c] : 0;
+        }
+        if (!word)
+            continue;
+        if (first)
+            return 1;
+        total += __builtin_popcountll(word);
+        for (; word && found && (!limit || found->size() < limit); word &= word-1)
+            found->push_back((uint64_t)position * 64 + __builtin_ctzll(word));
+    }
+    return total;
+}
+
+uint64_t index_reader::intersect(const uint32_t sets[], size_t count, uint64_t limit, vector <uint64_t> & found) const
+{
+    return scan(sets, count, limit, &found, false);
+}
+
+bool index_reader::any(const uint32_t sets[], size_t count) const
+{
+    return scan(sets, count, 0, nullptr, true) > 0;
+}
@@ -0,0 +1,138 @@
+// Search instrumentation: counters of the search threads and JSON snapshots.
+//
+// Last update: 10/17/2026
+
+#include "IQpuzzler_metrics.hpp"
+
+#include <fstream>              // ofstream
+#include <cstdio>               // rename
+#include <memory>               // unique_ptr
+#include <algorithm>            // fill
+#include <vector>               // vector
+#include <thread>               // thread
+#include <mutex>                // mutex, lock_guard, unique_lock
+#include <condition_variable>   // condition_variable
+#include <chrono>               // snapshot period, run time
+
+thread_local metric_block * metric_local = nullptr;
+
+vector <unique_ptr <metric_block> > metric_blocks;  // counters of all threads (kept after a thread has finished)
+mutex metric_blocks_lock;
+
+string metric_file, metric_board;
+uint8_t metric_partcount;
+const atomic <uint64_t> * metric_solutions;
+chrono::steady_clock::time_point metric_start;
+
+thread publisher;
+bool metric_stop = false;
+mutex metric_stop_lock;
+condition_variable metric_stop_signal;
+
+const char * const metric_name[METRICS] = {"tried", "overlap", "cavity", "pocket_small", "pocket_fit", "region", "nodes"};
+
+metric_block * metric_register()
+{
+    lock_guard <mutex> guard(metric_blocks_lock);
+    metric_blocks.emplace_back(new metric_block());     // value-initialized: all counters 0
+    return metric_local = metric_blocks.back().get();
+}
+
+// prints counters as JSON array
+void write_counters(ofstream & out, const uint64_t count[METRICS])
+{
+    out << "[";
+    for (int m = 0; m < METRICS; m++)
+        out << (m ? ", " : "") << count[m];
+    out << "]";
+}
+
+// sums the counters of all threads and replaces the snapshot file
+void write_snapshot(bool running)
+{
+    static uint64_t sum[METRIC_DEPTHS][METRIC_PARTS][METRICS];
+    uint64_t total[METRICS] = {}, depth_total[METRICS];
+    string temporary = metric_file + ".tmp";
+    ofstream out(temporary, ios::trunc);
+    bool first_depth = true;
+
+    fill(&sum[0][0][0], &sum[0][0][0] + METRIC_DEPTHS*METRIC_PARTS*METRICS, 0);
+    {
+        lock_guard <mutex> guard(metric_blocks_lock);
+        for (size_t b = 0; b < metric_blocks.size(); b++)
+            for (int d = 0; d < METRIC_DEPTHS; d++)
+                for (int p = 0; p < METRIC_PARTS; p++)
+                    for (int m = 0; m < METRICS; m++)
+                        sum[d][p][m] += metric_blocks[b]->count[d][p][m].load(memory_order_relaxed);
+    }
+    for (int d = 0; d < METRIC_DEPTHS; d++)
+        for (int p = 0; p < METRIC_PARTS; p++)
+            for (int m = 0; m < METRICS; m++)
+                total[m] += sum[d][p][m];
+
+    out << "{\n  \"board\": \"" << metric_board << "\",\n  \"running\": " << (running ? "true" : "false")
+        << ",\n  \"seconds\": " << chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - metric_start).count() / 1000.0
+        << ",\n  \"solutions\": " << metric_solutions->load() << ",\n  \"counters\": [";
+    for (int m = 0; m < METRICS; m++)
+        out << (m ? ", " : "") << "\"" << metric_name[m] << "\"";
+    out << "],\n  \"total\": ";
+    write_counters(out, total);
+    out << ",\n  \"depths\": [";
+    // one entry for each depth with placements, with the counters of each part
+    for (int d = 0; d < METRIC_DEPTHS; d++)
+    {
+        bool first_part = true;
+        fill(depth_total, depth_total + METRICS, 0);
+        for (int p = 0; p < METRIC_PARTS; p++)
+            for (int m = 0; m < METRICS; m++)
+                depth_total[m] += sum[d][p][m];
+        if (!depth_total[METRIC_TRIED])
+            continue;
+        out << (first_depth ? "\n" : ",\n") << "    {\"depth\": " << d << ", \"total\": ";
+        write_counters(out, depth_total);
+        out << ", \"parts\": {";
+        for (int p = 1; p <= metric_partcount && p < METRIC_PARTS; p++)
+            if (sum[d][p][METRIC_TRIED])
+            {
+                out << (first_part ? "" : ", ") << "\"" << (char)(p+64) << "\": ";
+                write_counters(out, sum[d][p]);
+                first_part = false;
+            }
+        out << "}}";
+        first_depth = false;
+    }
+    out << "\n  ]\n}\n";
+    out.close();
+    if (!out.fail())
+        rename(temporary.c_str(), metric_file.c_str());
+}
+
+void start_metrics(const string & filename, const string & board, uint8_t partcount, const atomic <uint64_t> * solutions)
+{
+    metric_file = filename;
+    metric_board = board;
+    metric_partcount = partcount;
+    metric_solutions = solutions;
+    metric_start = chrono::steady_clock::now();
+    metric_stop = false;
+
+    publisher = thread([]()
+    {
+        unique_lock <mutex> guard(metric_stop_lock);
+        while (!metric_stop_signal.wait_for(guard, chrono::milliseconds(METRIC_INTERVAL_MS), []() { return metric_stop; }))
+            write_snapshot(true);
+    });
+}
+
+void stop_metrics()
+{
+    if (!publisher.joinable())
+        return;
+    {
+        lock_guard <mutex> guard(metric_stop_lock);
+        metric_stop = true;
+    }
+    metric_stop_signal.notify_one();
+    publisher.join();
+    write_snapshot(false);
+}
@@ -0,0 +1,202 @@
+// Command line options for the IQpuzzler solvers.
+//
+// Last update: 10/17/2026
+
+#include "IQpuzzler_options.hpp"
+
+#include <iostream>     // cerr, endl
+#include <cstdlib>      // exit, strtoul, strtod
+
+void usage(const char *program)
+{
+    cerr << "Usage: " << program << " [filename] [--threads N] [--render-hz F] [--quiet] [--branch part|first|fewest]\n"
+         << "       [--symmetry break|dedup|off] [--compile] [--output text|binary] [--convert] [--solution N]\n"
+         << "       [--checkpoint S] [--resume] [--shard I/N] [--merge N] [--count] [--memory MB]\n"
+         << "       [--challenge F] [--limit K] [--depth D] [--stats N] [--metrics F]\n"
+         << "       [--serve PATH] [--index] [--lookup F] [--exists] [--cpu auto|baseline|bmi2|avx2]" << endl;
+    exit(1);
+}
+
+// reads numeric argument of option at argv[i+1]
+unsigned long read_count(int argc, char *argv[], int i)
+{
+    char *end;
+    unsigned long n;
+
+    if (i+1 >= argc)
+        usage(argv[0]);
+    n = strtoul(argv[i+1], &end, 10);
+    if (*end || end == argv[i+1])
+        usage(argv[0]);
+    return n;
+}
+
+// reads shard argument I/N of option at argv[i+1]
+void read_shard(int argc, char *argv[], int i, unsigned & shard, unsigned & shards)
+{
+    char *end;
+
+    if (i+1 >= argc)
+        usage(argv[0]);
+    shard = strtoul(argv[i+1], &end, 10);
+    if (*end != '/' || end == argv[i+1])
+        usage(argv[0]);
+    shards = strtoul(end+1, &end, 10);
+    if (*end || shard < 1 || shard > shards)
+        usage(argv[0]);
+}
+
+// reads floating point argument of option at argv[i+1]
+double read_rate(int argc, char *argv[], int i)
+{
+    char *end;
+    double f;
+
+    if (i+1 >= argc)
+        usage(argv[0]);
+    f = strtod(argv[i+1], &end);
+    if (*end || end == argv[i+1] || !(f > 0))
+        usage(argv[0]);
+    return f;
+}
+
+options read_options(int argc, char *argv[])
+{
+    options opt;
+    bool named = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "--threads")
+        {
+            opt.threads = read_count(argc, argv, i++);
+            if (!opt.threads)
+                usage(argv[0]);
+        }
+        else if (arg == "--render-hz")
+            opt.render_hz = read_rate(argc, argv, i++);
+        else if (arg == "--quiet")
+            opt.quiet = true;
+        else if (arg == "--compile")
+            opt.compile = true;
+        else if (arg == "--checkpoint")
+            opt.checkpoint = read_count(argc, argv, i++);
+        else if (arg == "--resume")
+            opt.resume = true;
+        else if (arg == "--shard")
+            read_shard(argc, argv, i++, opt.shard, opt.shards);
+        else if (arg == "--merge")
+        {
+            opt.merge = read_count(argc, argv, i++);
+            if (!opt.merge)
+                usage(argv[0]);
+        }
+        else if (arg == "--count")
+            opt.count = true;
+        else if (arg == "--memory")
+        {
+            opt.memory = read_count(argc, argv, i++);
+            if (!opt.memory)
+                usage(argv[0]);
+        }
+        else if (arg == "--depth")
+        {
+            opt.depth = read_count(argc, argv, i++);
+            if (!opt.depth)
+                usage(argv[0]);
+        }
+        else if (arg == "--stats")
+        {
+            opt.stats = read_count(argc, argv, i++);
+            if (!opt.stats)
+                usage(argv[0]);
+        }
+        else if (arg == "--challenge" && i+1 < argc)
+            opt.challenge = argv[++i];
+        else if (arg == "--limit")
+            opt.limit = read_count(argc, argv, i++);
+        else if (arg == "--index")
+            opt.index = true;
+        else if (arg == "--lookup" && i+1 < argc)
+            opt.lookup = argv[++i];
+        else if (arg == "--exists")
+            opt.exists = true;
+        else if (arg == "--serve" && i+1 < argc)
+            opt.serve = argv[++i];
+        else if (arg == "--metrics" && i+1 < argc)
+            opt.metrics = argv[++i];
+        else if (arg == "--convert")
+            opt.convert = true;
+        else if (arg == "--solution")
+        {
+            opt.solution = read_count(argc, argv, i++);
+            if (!opt.solution)
+                usage(argv[0]);
+        }
+        else if (arg == "--output" && i+1 < argc)
+        {
+            string format = argv[++i];
+            if (format == "text")
+                opt.output = OUTPUT_TEXT;
+            else if (format == "binary")
+                opt.output = OUTPUT_BINARY;
+            else
+                usage(argv[0]);
+        }
+        else if (arg == "--branch" && i+1 < argc)
+        {
+            string mode = argv[++i];
+            if (mode == "part")
+                opt.branch = BRANCH_PART;
+            else if (mode == "first")
+                opt.branch = BRANCH_FIRST;
+            else if (mode == "fewest")
+                opt.branch = BRANCH_FEWEST;
+            else
+                usage(argv[0]);
+        }
+        else if (arg == "--cpu" && i+1 < argc)
+        {
+            string variant = argv[++i];
+            if (variant == "auto")
+                opt.cpu = CPU_AUTO;
+            else if (variant == "baseline")
+                opt.cpu = CPU_BASELINE;
+            else if (variant == "bmi2")
+                opt.cpu = CPU_BMI2;
+            else if (variant == "avx2")
+                opt.cpu = CPU_AVX2;
+            else
+                usage(argv[0]);
+        }
+        else if (arg == "--symmetry" && i+1 < argc)
+        {
+            string mode = argv[++i];
+            if (mode == "break")
+                opt.symmetry = SYMMETRY_BREAK;
+            else if (mode == "dedup")
+                opt.symmetry = SYMMETRY_DEDUP;
+            else if (mode == "off")
+                opt.symmetry = SYMMETRY_OFF;
+            else
+                usage(argv[0]);
+        }
+        else if (arg.size() && arg[0] != '-' && !named)
+        {
+            opt.name = arg;
+            named = true;
+        }
+        else if (arg.size() && arg[0] != '-')
+            opt.sets.push_back(arg);
+        else
+            usage(argv[0]);
+    }
+    // several piece sets only for the daemon
+    if (opt.sets.size() && opt.serve.empty())
+        usage(argv[0]);
+    // bounded search only without counting (the transposition table holds complete counts)
+    if (opt.count && opt.depth)
+        usage(argv[0]);
+    return opt;
+}
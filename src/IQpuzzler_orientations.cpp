@@ -0,0 +1,123 @@
+// Generator of part orientations: built-in part set of the original game and generation of other sets at runtime.
+//
+// Last update: 10/17/2026
+
+#include "IQpuzzler_orientations.hpp"
+
+// base shapes of the original game (as in pre-processing/IQpuzzler_original.m)
+constexpr shape_dots ORIG_SHAPES[] =
+{
+    base_shape({{0,2}, {0,1}, {0,0}, {1,0}, {2,0}}),    // mid blue, symmetric L
+    base_shape({{0,1}, {0,0}, {1,0}, {2,0}, {3,0}}),    // red, long L
+    base_shape({{0,2}, {0,1}, {1,1}, {1,0}, {2,1}}),    // orange
+    base_shape({{0,0}, {1,0}, {1,1}, {2,0}}),           // dark green, T
+    base_shape({{0,0}, {1,0}, {1,1}, {2,1}, {2,2}}),    // magenta, M
+    base_shape({{0,1}, {0,0}, {1,0}, {2,0}, {2,1}}),    // light green, U
+    base_shape({{0,0}, {0,1}, {0,2}, {0,3}, {1,1}}),    // yellow
+    base_shape({{0,0}, {0,1}, {1,1}, {1,2}, {1,3}}),    // pink
+    base_shape({{0,0}, {1,0}, {2,0}, {0,1}, {1,1}}),    // cyan
+    base_shape({{0,0}, {1,0}, {1,1}, {2,1}}),           // dark red
+    base_shape({{0,1}, {0,0}, {1,0}, {2,0}}),           // dark blue, L
+    base_shape({{1,0}, {0,0}, {0,1}})                   // light blue, short L
+};
+
+// 2D boards: symmetric L only in one orientation (the board symmetries map its other orientations onto it)
+constexpr builtin_part ORIG_PARTS_2D[] =
+{
+    {0, 0, 1, {0}}, {1, 0}, {2, 0}, {3, 0}, {4, 0}, {5, 0}, {6, 0}, {7, 0}, {8, 0}, {9, 0}, {10, 0}, {11, 0}
+};
+
+// pyramid: red L first with one flat and four upright orientations, search order of parts and first orientations
+// as in bin/orig.3di
+constexpr builtin_part ORIG_PARTS_3D[] =
+{
+    {1, 0, 5, {0, 16, 17, 18, 19}}, {2, 2}, {3, 1}, {5, 2}, {6, 5}, {7, 0}, {0, 0}, {4, 0}, {10, 0}, {8, 0}, {9, 0}, {11, 0}
+};
+
+constexpr builtin_table<12> ORIG_2D = builtin_orientations(ORIG_SHAPES, ORIG_PARTS_2D, 2);
+constexpr builtin_table<12> ORIG_3D = builtin_orientations(ORIG_SHAPES, ORIG_PARTS_3D, 3);
+
+// copies a built-in table into shapes
+template <size_t parts>
+void copy_table(const builtin_table<parts> & table, shape_table & shapes)
+{
+    shapes = shape_table();
+    shapes.partcount = table.partcount;
+    shapes.part_begin.assign(table.part_begin, table.part_begin + parts+2);
+    shapes.part.assign(table.part, table.part + table.orientations);
+    shapes.dots.assign(table.dots, table.dots + table.orientations);
+    shapes.first.assign(table.first, table.first + table.orientations);
+    shapes.dx.assign(table.dx, table.dx + table.dot_count);
+    shapes.dy.assign(table.dy, table.dy + table.dot_count);
+    shapes.dz.assign(table.dz, table.dz + table.dot_count);
+}
+
+bool builtin_shapes(const string & name, uint8_t dimensions, shape_table & shapes)
+{
+    if (name != "orig")
+        return false;
+    copy_table(dimensions == 3 ? ORIG_3D : ORIG_2D, shapes);
+    return true;
+}
+
+string generate_shapes(const shape_table & bases, uint8_t dimensions, shape_table & shapes)
+{
+    shapes = shape_table();
+    shapes.part_begin.push_back(0);     // part_begin[0] is not used
+    for (uint8_t p = 1; p <= bases.partcount; p++)
+    {
+        uint32_t o = bases.part_begin[p];
+        if (bases.dots[o] > SHAPE_DOTS)
+            return "part " + to_string(p) + " has more than " + to_string(SHAPE_DOTS) + " dots";
+        shape_dots base;
+        base.dots = bases.dots[o];
+        for (uint8_t i = 0; i < base.dots; i++)
+        {
+            base.x[i] = bases.dx[bases.first[o] + i];
+            base.y[i] = bases.dy[bases.first[o] + i];
+        }
+        shape_orientations all = dimensions == 3 ? orientations_3d(base) : orientations_2d(base);
+
+        shapes.partcount++;
+        shapes.part_begin.push_back(shapes.orientations());
+        for (uint8_t k = 0; k < all.count; k++)
+        {
+            const shape_dots & s = all.orientation[k];
+            shapes.part.push_back(p);
+            shapes.dots.push_back(s.dots);
+            shapes.first.push_back(shapes.dx.size());
+            for (uint8_t i = 0; i < s.dots; i++)
+            {
+                if (s.x[i] > 9 || s.y[i] > 9 || s.z[i] > 9)     // (single digit coordinates in input files)
+                    return "part " + to_string(p) + " is too large";
+                shapes.dx.push_back(s.x[i]);
+                shapes.dy.push_back(s.y[i]);
+                shapes.dz.push_back(s.z[i]);
+            }
+        }
+    }
+    shapes.part_begin.push_back(shapes.orientations());     // end of last part
+    return "";
+}
+
+// same layout as the files written by the MATLAB tool: one orientation per line, empty line between parts
+void write_shapes(ostream & out, const shape_table & shapes, uint8_t dimensions)
+{
+    for (uint8_t p = 1; p <= shapes.partcount; p++)
+    {
+        out << "[";
+        for (uint32_t o = shapes.part_begin[p]; o < shapes.part_begin[p+1]; o++)
+        {
+            out << "[";
+            for (uint32_t i = shapes.first[o]; i < shapes.first[o] + shapes.dots[o]; i++)
+            {
+                out << "[" << (int)shapes.dx[i] << "," << (int)shapes.dy[i];
+                if (dimensions == 3)
+                    out << "," << (int)shapes.dz[i];
+                out << (i+1 < shapes.first[o] + shapes.dots[o] ? "]," : "]");
+            }
+            out << (o+1 < shapes.part_begin[p+1] ? "],\n" : "]");
+        }
+        out << (p < shapes.partcount ? "],\n\n" : "]\n");
+    }
+}
@@ -1,99 +1,196 @@
-// Reads text file (*.2di, *.3di) for IQpuzzler and fills vector array with data.
-// Expected format is a list of parts (separated by ','),
-// where each part is a list of orientations ( start of list with '[', end of list with ']'),
-// where each orientation is a list of dots (logically same number of dots within same part, usually 3 to 5, depending on part size),
-// where each dot is a list of coordinates (single digit, non-negative integers, x,y, optional z for 3D puzzle),
-// defining the possible geometric orientations of each dot of the parts.
-// Thus, the text in the file can also be used directly in Python or C++ (replace [] by {}) to initialize lists / vector arrays.
-//
-// No checks are performed to verify correctness of the data (except counting the number of parts).
-// Wrong data or format will lead to undefined behaviour of the read functions or the solution algorithm.
-// Characters other than begin of list '[', end of list ']', separator ',' or single digits will be ignored and can be used for comments.
-//
-// Input files can be created automatically with the provided MATLAB / Octave tool
-// for different game configurations (e.g. original IQpuzzlerPRO game).
+// Reads text file (*.2di, *.3di) for IQpuzzler and fills the shape table with its data.
+// Single pass over the whole file in memory, with line and column of each error.
 //
 // Written by Stefan Abendroth (sab@ab-solut.com)
-// Last update: 03/06/2022
+// Last update: 10/17/2026
 
 #include "IQpuzzler_read_input.hpp"
 
-uint8_t read_number(ifstream& partfile)
+#include <cstdlib>      // exit
+#include <iterator>     // istreambuf_iterator
+
+// position in input file
+struct text_position
 {
-    char c = 0;
-    while ( (c < '0' || c > '9') && !partfile.eof() )  // read in single digit number
-        partfile >> c;
-    return c - '0';     // convert to number by subtracting ASCII codes
-}
+    size_t line;
+    size_t col;
+};
 
-vector <uint8_t> read_dot(ifstream& partfile)
+// input file in one buffer, with current position
+struct input_text
 {
-    char c = 0;
-    vector <uint8_t> dot;
+    string name;            // file name for error messages
+    string text;
+    size_t pos = 0;
+    size_t line = 1;
+    size_t line_start = 0;  // position of first character of current line
 
-    while (c!='[' && !partfile.eof())
-        partfile >> c;      // read in open bracket
+    text_position here() const { return {line, pos - line_start + 1}; }
 
-    while (c!=']' && !partfile.eof())
+    [[noreturn]] void error(text_position at, const string & message) const
     {
-        dot.push_back(read_number(partfile));   // get dot position
-        do
-            partfile >> c;      // read in next delimiter
-        while (c!=',' && c!=']' && !partfile.eof());
+        cerr << name << ":";
+        if (at.line)
+            cerr << at.line << ":" << at.col << ":";
+        cerr << " error: " << message << endl;
+        exit(1);
     }
-    return dot;
-}
 
-vector <vector <uint8_t> > read_orientation(ifstream& partfile)
-{
-    char c = 0;
-    vector <vector <uint8_t> > orientation;
+    // skips blanks, line breaks and comments, returns next character (0 at end of file)
+    char peek()
+    {
+        while (pos < text.size())
+        {
+            char c = text[pos];
+            if (c == '\n')
+            {
+                line++;
+                line_start = ++pos;
+            }
+            else if (c == ' ' || c == '\t' || c == '\r')
+                pos++;
+            else if (c == '/' && pos+1 < text.size() && text[pos+1] == '/')
+                while (pos < text.size() && text[pos] != '\n')
+                    pos++;
+            else
+                return c ? c : 1;   // stray NUL character is not end of file
+        }
+        return 0;
+    }
 
-    while (c!='[' && !partfile.eof())
-        partfile >> c;      // read in open bracket
+    // describes next character for error messages
+    string found()
+    {
+        char c = peek();
+        if (!c)
+            return "end of file";
+        return string("'") + c + "'";
+    }
 
-    while (c!=']' && !partfile.eof())
+    // reads expected character
+    void expect(char c, const char * what)
     {
-        orientation.push_back(read_dot(partfile));   // get dot position
-        do
-            partfile >> c;      // read in next delimiter
-        while (c!=',' && c!=']' && !partfile.eof());
+        if (peek() != c)
+            error(here(), string("expected ") + what + ", found " + found());
+        pos++;
     }
-    return orientation;
+
+    // reads ',' or the end of a list, returns true at end of list
+    bool next_item(const char * list, text_position opened)
+    {
+        char c = peek();
+        if (c == LIST_SEPARATOR || c == END_OF_LIST)
+        {
+            pos++;
+            return c == END_OF_LIST;
+        }
+        error(here(), string("expected ',' or ']' in ") + list + " opened at line " + to_string(opened.line)
+                      + ", column " + to_string(opened.col) + ", found " + found());
+    }
+};
+
+// reads single digit coordinate
+int8_t read_coordinate(input_text & in)
+{
+    char c = in.peek();
+    text_position start = in.here();
+
+    if (c < '0' || c > '9')
+        in.error(start, "expected coordinate (single digit), found " + in.found());
+    in.pos++;
+    if (in.pos < in.text.size() && in.text[in.pos] >= '0' && in.text[in.pos] <= '9')
+        in.error(start, "coordinate has more than one digit");
+    return c - '0';
 }
 
-vector <vector <vector <uint8_t> > > read_part(ifstream& partfile)
+// reads dot [x,y] or [x,y,z] and appends it to shapes
+void read_dot(input_text & in, shape_table & shapes, uint8_t dimensions)
 {
-    char c = 0;
-    vector <vector <vector <uint8_t> > > p;
+    int8_t coordinate[3] = {0, 0, 0};
+    uint8_t count = 0;
 
-    while (c!='[' && !partfile.eof())
-        partfile >> c;      // read in open bracket
+    in.peek();
+    text_position opened = in.here();
+    in.expect(BEGIN_OF_LIST, "'[' (begin of dot)");
+    do
+    {
+        int8_t value = read_coordinate(in);
+        if (count < 3)
+            coordinate[count] = value;
+        count++;
+    }
+    while (!in.next_item("dot", opened));
+    if (count != dimensions)
+        in.error(opened, "dot has " + to_string(count) + " coordinates, expected " + to_string(dimensions));
+    shapes.dx.push_back(coordinate[0]);
+    shapes.dy.push_back(coordinate[1]);
+    shapes.dz.push_back(coordinate[2]);
+}
+
+// reads list of dots and appends orientation to shapes
+void read_orientation(input_text & in, shape_table & shapes, uint8_t dimensions)
+{
+    size_t first = shapes.dx.size();
+    uint8_t part_number = shapes.partcount;
 
-    while (c!=']' && !partfile.eof())
+    in.peek();
+    text_position opened = in.here();
+    in.expect(BEGIN_OF_LIST, "'[' (begin of orientation)");
+    do
     {
-        p.push_back(read_orientation(partfile));   // get dot position
-        do
-            partfile >> c;      // read in next delimiter
-        while (c!=',' && c!=']' && !partfile.eof());
+        if (shapes.dx.size() - first == UINT8_MAX)
+            in.error(opened, "orientation has more than " + to_string(UINT8_MAX) + " dots");
+        read_dot(in, shapes, dimensions);
     }
-    return p;
+    while (!in.next_item("orientation", opened));
+
+    uint8_t dots = shapes.dx.size() - first;
+    if (shapes.orientations() > shapes.part_begin[part_number] && dots != shapes.dots[shapes.part_begin[part_number]])
+        in.error(opened, "orientation has " + to_string(dots) + " dots, first orientation of part "
+                         + to_string(part_number) + " has " + to_string(shapes.dots[shapes.part_begin[part_number]]));
+    shapes.part.push_back(part_number);
+    shapes.dots.push_back(dots);
+    shapes.first.push_back(first);
 }
 
-uint8_t read_input(string inputfile, vector <vector <vector <vector <uint8_t> > > > & part)
+// reads list of orientations of next part
+void read_part(input_text & in, shape_table & shapes, uint8_t dimensions)
 {
-    ifstream partfile;   // input: file with part data
-    vector <vector <vector <uint8_t> > > p;
+    in.peek();
+    text_position opened = in.here();
+    if (shapes.partcount == UINT8_MAX)
+        in.error(opened, "more than " + to_string(UINT8_MAX) + " parts");
+    in.expect(BEGIN_OF_LIST, "'[' (begin of part)");
+    shapes.partcount++;
+    shapes.part_begin.push_back(shapes.orientations());
+    do
+        read_orientation(in, shapes, dimensions);
+    while (!in.next_item("part", opened));
+}
 
-    partfile.open (inputfile);
+uint8_t read_input(const string & inputfile, shape_table & shapes, uint8_t dimensions)
+{
+    input_text in;
+    ifstream partfile(inputfile, ios::binary);   // input: file with part data
 
-    while (!partfile.eof())
+    in.name = inputfile;
+    if (!partfile)
+        in.error({0, 0}, "can't open file");
+    in.text.assign(istreambuf_iterator<char>(partfile), istreambuf_iterator<char>());
+    partfile.close();
+
+    shapes = shape_table();
+    shapes.part_begin.push_back(0);     // part_begin[0] is not used
+    // parts separated by ',' (optional after last part)
+    do
     {
-        p=read_part(partfile);
-        if (p.size())
-            part.push_back(p);
+        read_part(in, shapes, dimensions);
+        if (in.peek() == LIST_SEPARATOR)
+            in.pos++;
+        else if (in.peek())
+            in.error(in.here(), "expected ',' or end of file after part " + to_string(shapes.partcount) + ", found " + in.found());
     }
-    
-    partfile.close();
-    return part.size()-1;                // don't count empty part[0]
-}
\ No newline at end of file
+    while (in.peek());
+    shapes.part_begin.push_back(shapes.orientations());     // end of last part
+    return shapes.partcount;
+}
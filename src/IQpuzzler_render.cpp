@@ -0,0 +1,99 @@
+// Terminal visualization of the current search, decoupled from the search threads.
+//
+// Last update: 10/17/2026
+
+#include "IQpuzzler_render.hpp"
+
+#include <iostream>             // cout, flush
+#include <thread>               // thread
+#include <mutex>                // mutex, lock_guard, unique_lock
+#include <condition_variable>   // condition_variable
+#include <chrono>               // render period
+
+atomic <bool> render_request(false);
+
+vector <screen_position> render_layout;
+vector <string> render_color;
+uint16_t render_status_row;
+const atomic <uint64_t> * render_solutions;
+
+vector <uint8_t> snapshot;      // latest board published by search threads
+bool snapshot_new = false;
+mutex snapshot_lock;
+vector <uint8_t> frame;         // board currently shown in terminal
+
+thread renderer;
+bool render_stop = false;
+mutex stop_lock;
+condition_variable stop_signal;
+
+void render_publish(const uint8_t cells[])
+{
+    if (!snapshot_lock.try_lock())      // renderer is reading previous snapshot -> don't wait, try again in next step
+        return;
+    copy(cells, cells + snapshot.size(), snapshot.begin());
+    snapshot_new = true;
+    render_request.store(false, memory_order_relaxed);
+    snapshot_lock.unlock();
+}
+
+// redraw changed fields and status line
+void draw_frame()
+{
+    vector <uint8_t> cells;
+    string out;
+
+    {
+        lock_guard <mutex> guard(snapshot_lock);
+        if (snapshot_new)
+            cells = snapshot;
+        snapshot_new = false;
+    }
+    for (size_t i = 0; i < cells.size(); i++)
+        if (cells[i] != frame[i])
+        {
+            frame[i] = cells[i];
+            // set color and print square (two blanks with background color) at position of field
+            out += render_color[cells[i] % render_color.size()];
+            out += "\033[" + to_string(render_layout[i].row) + ";" + to_string(render_layout[i].col) + "H  ";
+        }
+    out += "\033[0;0m\033[" + to_string(render_status_row) + ";1HSolutions: " + to_string(render_solutions->load()) + "\033[K";
+    cout << out << flush;
+}
+
+void start_renderer(const vector <screen_position> & layout, const vector <string> & color, uint16_t status_row,
+                    double hz, const atomic <uint64_t> * solutions)
+{
+    render_layout = layout;
+    render_color = color;
+    render_status_row = status_row;
+    render_solutions = solutions;
+    snapshot.assign(layout.size(), 0);
+    frame.assign(layout.size(), UINT8_MAX);     // draw all fields in first frame
+    render_stop = false;
+
+    renderer = thread([hz]()
+    {
+        chrono::duration <double> period(1.0 / hz);
+        unique_lock <mutex> guard(stop_lock);
+        while (!render_stop)
+        {
+            render_request.store(true, memory_order_relaxed);      // ask search threads for a new snapshot
+            stop_signal.wait_for(guard, period, []() { return render_stop; });
+            draw_frame();
+        }
+    });
+}
+
+void stop_renderer()
+{
+    if (!renderer.joinable())
+        return;
+    {
+        lock_guard <mutex> guard(stop_lock);
+        render_stop = true;
+    }
+    stop_signal.notify_one();
+    renderer.join();
+    render_request.store(false, memory_order_relaxed);
+}
@@ -0,0 +1,212 @@
+// Solver daemon on a Unix domain socket: connections, query queue and worker pool.
+//
+// Last update: 10/17/2026
+
+#include "IQpuzzler_server.hpp"
+
+#include <iostream>             // cout, endl
+#include <memory>               // shared_ptr, weak_ptr
+#include <deque>                // deque
+#include <thread>               // thread
+#include <mutex>                // mutex, lock_guard, unique_lock
+#include <condition_variable>   // condition_variable
+#include <atomic>               // atomic
+#include <cstring>              // strncpy, strerror
+#include <cerrno>               // errno, EINTR
+#include <csignal>              // sigaction, SIGINT, SIGTERM
+#include <poll.h>               // poll
+#include <sys/socket.h>         // socket, bind, listen, accept, recv, send, shutdown
+#include <sys/un.h>             // sockaddr_un
+#include <unistd.h>             // close, unlink
+
+struct connection
+{
+    int fd;
+    mutex write_lock;       // answers of several workers are not interleaved
+
+    ~connection() { close(fd); }
+};
+
+struct pending_query
+{
+    shared_ptr <connection> client;
+    chrono::steady_clock::time_point received;     // start of the time budget
+    query q;
+    query_placement parts[SERVER_MAX_PARTS];
+};
+
+deque <pending_query> pending;      // queries waiting for a worker
+mutex pending_lock;
+condition_variable pending_signal;
+bool server_closing = false;        // no more queries, workers stop when queue is empty
+
+vector <weak_ptr <connection> > connections;    // open connections (to be shut down at exit)
+unsigned readers = 0;               // running reader threads
+mutex connections_lock;
+condition_variable readers_done;
+
+atomic <bool> server_stop(false);
+atomic <uint64_t> answered(0);
+
+void stop_server(int)
+{
+    server_stop.store(true);
+}
+
+// reads n bytes, returns false at end of connection
+bool read_full(int fd, void * data, size_t n)
+{
+    for (size_t done = 0; done < n; )
+    {
+        ssize_t r = recv(fd, (uint8_t *)data + done, n - done, 0);
+        if (r < 0 && errno == EINTR)
+            continue;
+        if (r <= 0)
+            return false;
+        done += r;
+    }
+    return true;
+}
+
+// writes n bytes, returns false if the connection is closed
+bool write_full(int fd, const void * data, size_t n)
+{
+    for (size_t done = 0; done < n; )
+    {
+        ssize_t w = send(fd, (const uint8_t *)data + done, n - done, MSG_NOSIGNAL);
+        if (w < 0 && errno == EINTR)
+            continue;
+        if (w <= 0)
+            return false;
+        done += w;
+    }
+    return true;
+}
+
+// reads queries of a connection into the queue until the client closes the connection
+void read_queries(shared_ptr <connection> client)
+{
+    pending_query p;
+    query_placement ignored;
+
+    p.client = client;
+    while (read_full(client->fd, &p.q, sizeof(p.q)))
+    {
+        bool complete = true;
+        for (unsigned i = 0; i < p.q.count && complete; i++)    // (parts beyond SERVER_MAX_PARTS: query is invalid)
+            complete = read_full(client->fd, i < SERVER_MAX_PARTS ? &p.parts[i] : &ignored, sizeof(query_placement));
+        if (!complete)
+            break;
+        p.received = chrono::steady_clock::now();
+        {
+            lock_guard <mutex> guard(pending_lock);
+            pending.push_back(p);
+        }
+        pending_signal.notify_one();
+    }
+    client.reset();
+    p.client.reset();
+    lock_guard <mutex> guard(connections_lock);
+    if (--readers == 0)
+        readers_done.notify_all();
+}
+
+// takes the queries from the queue one at a time, solves them and sends each answer as soon as it is ready
+void answer_queries(const query_handler & handler)
+{
+    pending_query p;
+    vector <uint8_t> reply;
+
+    while (true)
+    {
+        {
+            unique_lock <mutex> guard(pending_lock);
+            pending_signal.wait(guard, []() { return pending.size() || server_closing; });
+            if (pending.empty())
+                return;
+            p = pending.front();
+            pending.pop_front();
+        }
+        reply.clear();
+        handler(p.q, p.parts, p.received, reply);
+        {
+            lock_guard <mutex> guard(p.client->write_lock);
+            write_full(p.client->fd, reply.data(), reply.size());
+        }
+        answered.fetch_add(1);
+        p.client.reset();
+    }
+}
+
+uint64_t run_server(const string & path, unsigned threads, const query_handler & handler)
+{
+    struct sockaddr_un address = {};
+    struct sigaction action = {};
+    vector <thread> workers;
+    int listener;
+
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        cout<<"Socket path too long: "<<path<<"."<<endl;
+        return 0;
+    }
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path)-1);
+    listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(path.c_str());   // socket of previous daemon
+    if (listener < 0 || bind(listener, (struct sockaddr *)&address, sizeof(address)) || listen(listener, SOMAXCONN))
+    {
+        cout<<"Can't listen on "<<path<<": "<<strerror(errno)<<"."<<endl;
+        if (listener >= 0)
+            close(listener);
+        return 0;
+    }
+    action.sa_handler = stop_server;    // (without SA_RESTART, so poll is interrupted)
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+
+    for (unsigned w = 0; w < threads; w++)
+        workers.push_back(thread(answer_queries, cref(handler)));
+    cout<<"Listening on "<<path<<" with "<<threads<<(threads == 1 ? " thread." : " threads.")<<endl;
+
+    while (!server_stop.load())
+    {
+        struct pollfd listening = {listener, POLLIN, 0};
+        if (poll(&listening, 1, 200) <= 0)
+            continue;
+        int fd = accept(listener, nullptr, nullptr);
+        if (fd < 0)
+            continue;
+        shared_ptr <connection> client(new connection());
+        client->fd = fd;
+        {
+            lock_guard <mutex> guard(connections_lock);
+            for (size_t c = connections.size(); c-- > 0; )
+                if (connections[c].expired())
+                    connections.erase(connections.begin() + c);
+            connections.push_back(client);
+            readers++;
+        }
+        thread(read_queries, client).detach();
+    }
+
+    // wake up readers of open connections and wait for them, then let the workers finish the queue
+    {
+        unique_lock <mutex> guard(connections_lock);
+        for (size_t c = 0; c < connections.size(); c++)
+            if (shared_ptr <connection> client = connections[c].lock())
+                shutdown(client->fd, SHUT_RD);
+        readers_done.wait(guard, []() { return readers == 0; });
+    }
+    {
+        lock_guard <mutex> guard(pending_lock);
+        server_closing = true;
+    }
+    pending_signal.notify_all();
+    for (unsigned w = 0; w < threads; w++)
+        workers[w].join();
+    close(listener);
+    unlink(path.c_str());
+    cout<<answered.load()<<" queries answered."<<endl;
+    return answered.load();
+}
@@ -0,0 +1,194 @@
+// Binary solution files with block index.
+//
+// Last update: 10/17/2026
+
+#include "IQpuzzler_solutions.hpp"
+
+#include <cstring>      // memcpy, memcmp
+#include <sys/mman.h>   // mmap, munmap
+#include <sys/stat.h>   // stat
+#include <fcntl.h>      // open
+#include <unistd.h>     // close, truncate
+
+bool solution_writer::open(const string & filename, const solution_header & h)
+{
+    header = h;
+    memcpy(header.magic, SOLUTION_MAGIC, sizeof(header.magic));
+    header.version = SOLUTION_VERSION;
+    header.block = SOLUTION_BLOCK;
+    header.solutions = 0;
+    blocks.clear();
+    file.open(filename, ios::binary | ios::trunc);
+    file.write((const char *)&header, sizeof(header));     // placeholder, header is written by close()
+    size = sizeof(header);
+    return file.good();
+}
+
+bool solution_writer::reopen(const string & filename, uint64_t offset, uint64_t solutions)
+{
+    ifstream in(filename, ios::binary);
+    vector <uint8_t> data(offset);
+    uint64_t position = sizeof(header);
+
+    if (offset < sizeof(header) || !in.read((char *)data.data(), offset))
+        return false;
+    in.close();
+    memcpy(&header, data.data(), sizeof(header));
+    if (memcmp(header.magic, SOLUTION_MAGIC, sizeof(header.magic)) || header.version != SOLUTION_VERSION)
+        return false;
+    // offsets of blocks and time stamp of last solution
+    blocks.clear();
+    for (header.solutions = 0; header.solutions < solutions; header.solutions++)
+    {
+        uint32_t delta = 0;
+        if (position >= offset)
+            return false;
+        if (header.solutions % SOLUTION_BLOCK == 0)
+        {
+            blocks.push_back(position);
+            previous_seconds = 0;
+        }
+        uint8_t first = data[position++];
+        if (first & SOLUTION_TIME)
+            for (uint8_t shift = 0; shift < 35 && position < offset; shift += 7)
+            {
+                delta |= (uint32_t)(data[position] & 0x7f) << shift;
+                if (!(data[position++] & 0x80))
+                    break;
+            }
+        previous_seconds += delta;
+        position += first & SOLUTION_LENGTH;
+    }
+    if (position != offset || truncate(filename.c_str(), offset))
+        return false;
+    file.open(filename, ios::binary | ios::in | ios::out);
+    file.seekp(offset);
+    size = offset;
+    return file.good();
+}
+
+uint64_t solution_writer::flush()
+{
+    file.flush();
+    return size;
+}
+
+void solution_writer::add(const uint8_t code[], uint8_t length, uint32_t seconds)
+{
+    uint8_t record[1 + 5 + SOLUTION_LENGTH];
+    size_t bytes = 1;
+    uint32_t delta;
+
+    if (header.solutions % SOLUTION_BLOCK == 0)
+    {   // new block, time stamp counts from 0
+        blocks.push_back(size);
+        previous_seconds = 0;
+    }
+    delta = seconds - previous_seconds;     // (parallel search may log solutions out of time order, delta wraps around)
+    record[0] = (length & SOLUTION_LENGTH) | (delta ? SOLUTION_TIME : 0);
+    for (; delta; delta >>= 7)
+        record[bytes++] = (delta & 0x7f) | (delta > 0x7f ? 0x80 : 0);
+    memcpy(record + bytes, code, length & SOLUTION_LENGTH);
+    bytes += length & SOLUTION_LENGTH;
+    file.write((const char *)record, bytes);
+    size += bytes;
+    previous_seconds = seconds;
+    header.solutions++;
+}
+
+bool solution_writer::close()
+{
+    header.index = size;
+    file.write((const char *)blocks.data(), blocks.size() * sizeof(uint64_t));
+    header.size = size + blocks.size() * sizeof(uint64_t);
+    file.seekp(0);
+    file.write((const char *)&header, sizeof(header));
+    file.close();
+    return !file.fail();
+}
+
+solution_reader::~solution_reader()
+{
+    if (base)
+        munmap((void *)base, length);
+}
+
+const solution_header * solution_reader::open(const string & filename)
+{
+    struct stat file_stat;
+    int fd;
+
+    if (stat(filename.c_str(), &file_stat) || (size_t)file_stat.st_size < sizeof(solution_header))
+        return nullptr;
+    fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return nullptr;
+    void * map = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED)
+        return nullptr;
+    base = (const uint8_t *)map;
+    length = file_stat.st_size;
+
+    header = (const solution_header *)base;
+    if (memcmp(header->magic, SOLUTION_MAGIC, sizeof(header->magic)) || header->version != SOLUTION_VERSION
+        || header->size != length || !header->block
+        || header->index + (header->solutions + header->block-1) / header->block * sizeof(uint64_t) != length)
+        return nullptr;
+    return header;
+}
+
+// decodes time stamp and length of solution at position, returns its code and moves position to the next solution
+const uint8_t * solution_reader::decode(uint64_t & position, uint8_t & code_length, uint32_t & seconds) const
+{
+    uint32_t delta = 0;
+    const uint8_t * code;
+
+    if (position >= header->index)
+        return nullptr;
+    code_length = base[position] & SOLUTION_LENGTH;
+    if (base[position++] & SOLUTION_TIME)
+        for (uint8_t shift = 0; shift < 35; shift += 7)
+        {
+            if (position >= header->index)
+                return nullptr;
+            delta |= (uint32_t)(base[position] & 0x7f) << shift;
+            if (!(base[position++] & 0x80))
+                break;
+        }
+    seconds += delta;
+    if (position + code_length > header->index)
+        return nullptr;
+    code = base + position;
+    position += code_length;
+    return code;
+}
+
+const uint8_t * solution_reader::get(uint64_t n, uint8_t & code_length, uint32_t & seconds) const
+{
+    uint64_t position;
+    const uint8_t * code = nullptr;
+
+    if (n >= header->solutions)
+        return nullptr;
+    memcpy(&position, base + header->index + n / header->block * sizeof(uint64_t), sizeof(position));
+    // skip solutions from start of block up to solution n
+    seconds = 0;
+    for (uint64_t k = n - n % header->block; k <= n; k++)
+        if (!(code = decode(position, code_length, seconds)))
+            return nullptr;
+    return code;
+}
+
+const uint8_t * solution_reader::next(uint8_t & code_length, uint32_t & seconds)
+{
+    if (current >= header->solutions)
+        return nullptr;
+    if (current % header->block == 0)
+    {
+        memcpy(&offset, base + header->index + current / header->block * sizeof(uint64_t), sizeof(offset));
+        seconds = 0;
+    }
+    current++;
+    return decode(offset, code_length, seconds);
+}
@@ -0,0 +1,81 @@
+// Work-stealing thread pool for parallel search.
+//
+// Last update: 10/17/2026
+
+#include "IQpuzzler_threads.hpp"
+
+#include <thread>               // thread
+#include <mutex>                // mutex, lock_guard, unique_lock
+#include <condition_variable>   // condition_variable
+#include <deque>                // deque
+#include <vector>               // vector
+#include <cstdint>              // uint8_t
+
+struct task_queue
+{
+    mutex lock;
+    deque <size_t> tasks;
+};
+
+void run_tasks(size_t taskcount, unsigned threads, const function <void(size_t)> & work, const function <void(size_t)> & merge)
+{
+    vector <task_queue> queue(threads);
+    vector <uint8_t> done(taskcount, 0);
+    mutex done_lock;
+    condition_variable done_signal;
+    vector <thread> worker;
+
+    for (size_t task = 0; task < taskcount; task++)
+        queue[task % threads].tasks.push_back(task);
+
+    for (unsigned w = 0; w < threads; w++)
+        worker.push_back(thread([&, w]()
+        {
+            size_t task;
+            bool found;
+            while (true)
+            {
+                found = false;
+                {   // take next task from own queue
+                    lock_guard <mutex> guard(queue[w].lock);
+                    if (queue[w].tasks.size())
+                    {
+                        task = queue[w].tasks.front();
+                        queue[w].tasks.pop_front();
+                        found = true;
+                    }
+                }
+                for (unsigned v = 1; v < threads && !found; v++)
+                {   // steal last task from other queue
+                    lock_guard <mutex> guard(queue[(w+v) % threads].lock);
+                    if (queue[(w+v) % threads].tasks.size())
+                    {
+                        task = queue[(w+v) % threads].tasks.back();
+                        queue[(w+v) % threads].tasks.pop_back();
+                        found = true;
+                    }
+                }
+                if (!found)     // all queues empty (no new tasks are created during search)
+                    return;
+                work(task);
+                {
+                    lock_guard <mutex> guard(done_lock);
+                    done[task] = 1;
+                }
+                done_signal.notify_one();
+            }
+        }));
+
+    // merge results in task order
+    for (size_t task = 0; task < taskcount; task++)
+    {
+        {
+            unique_lock <mutex> guard(done_lock);
+            done_signal.wait(guard, [&]() { return done[task] != 0; });
+        }
+        merge(task);
+    }
+
+    for (unsigned w = 0; w < threads; w++)
+        worker[w].join();
+}
@@ -0,0 +1,13 @@
+// Finds all solutions for IQ Puzzler pyramid by solving the exact coverage problem with Knuth's algorithm X.
+// Part definitions and orientations of the original game are built in (orig), other sets are read from filename.3di.
+// Creates Logfile "orig_pyra.3do" or filename_pyra.3do with solutions and timestamps (all symmetric solutions).
+// The matrix is built from the board shape, the solver is shared by all boards (see IQpuzzler_knuth.hpp).
+//
+// Last update: 10/17/2026
+
+#include "IQpuzzler_knuth.hpp"          // exact cover solver, templated on board geometry
+
+int main(int argc, char *argv[])
+{
+    return run_knuth <pyramid_geometry> (argc, argv);
+}